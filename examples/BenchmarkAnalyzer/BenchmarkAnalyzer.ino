@@ -0,0 +1,60 @@
+#include <AudioAnalyzer.h>
+#include <AudioBenchmark.h>
+
+#define AUDIO_SAMPLERATE 16000  // Input Audio sampling rate
+#define AUDIO_MSEC 32           // Capture period time
+#define BENCH_RUNS 200          // Runs per size
+#ifndef BENCH_INTERVAL_MSEC
+#define BENCH_INTERVAL_MSEC 10000  // Interval between reports (extras/host builds with 0)
+#endif
+
+static const size_t frames = AUDIO_SAMPLERATE*AUDIO_MSEC/1000;
+int16_t buffer[frames];
+float work[1024];
+
+static void fillNoise(int16_t* b, size_t n) {
+  uint32_t x = 1;
+  for (size_t i = 0; i < n; i++) {
+    x = x * 1664525 + 1013904223;  // 実行ごとに同じ系列にする
+    b[i] = (int16_t)(x >> 16);
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  fillNoise(buffer, frames);
+}
+
+void loop() {
+  char name[32];
+  AudioBenchmark::printHeader(Serial);
+  {
+    AudioAnalyzer analyzer;
+    AudioBenchmark bench("level peak/rms", frames, sizeof(buffer));
+    bench.run(BENCH_RUNS, [&]() { analyzer.analyze(AudioBlock<const int16_t>(buffer, frames, 1)); });
+    bench.report(Serial);
+  }
+  for (size_t n = 64; n <= 1024; n <<= 1) {
+    // FFT 単体 (回転因子は表引き)
+    AudioFft fft(n);
+    snprintf(name, sizeof(name), "fft %u", (unsigned)n);
+    AudioBenchmark bench(name, n, n * sizeof(float));
+    for (int i = 0; i < BENCH_RUNS; i++) {
+      for (size_t j = 0; j < n; j++) {
+        work[j] = buffer[j % frames];
+      }
+      bench.begin();
+      fft.forward(work);
+      bench.end();
+    }
+    bench.report(Serial);
+
+    // 窓掛け + FFT + パワー + レベルを 1 周期分
+    AudioAnalyzer analyzer(n);
+    snprintf(name, sizeof(name), "analyze period fft %u", (unsigned)n);
+    AudioBenchmark period(name, frames, sizeof(buffer));
+    period.run(BENCH_RUNS, [&]() { analyzer.analyze(AudioBlock<const int16_t>(buffer, frames, 1)); });
+    period.report(Serial);
+  }
+  delay(BENCH_INTERVAL_MSEC);
+}
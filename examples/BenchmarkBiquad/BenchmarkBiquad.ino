@@ -0,0 +1,63 @@
+#include <AudioBenchmark.h>
+#include <BiquadCascade.h>
+
+#define AUDIO_SAMPLERATE 48000  // Output Audio sampling rate
+#define AUDIO_MSEC 10           // Period time
+#define AUDIO_CHANNELS 2
+#define BENCH_RUNS 200          // Runs per kernel
+#ifndef BENCH_INTERVAL_MSEC
+#define BENCH_INTERVAL_MSEC 10000  // Interval between reports (extras/host builds with 0)
+#endif
+
+static const size_t frames = AUDIO_SAMPLERATE*AUDIO_MSEC/1000;
+int16_t buffer16[frames*AUDIO_CHANNELS];
+int32_t buffer32[frames*AUDIO_CHANNELS];
+float bufferFloat[frames*AUDIO_CHANNELS];
+
+static void fillNoise() {
+  uint32_t x = 1;
+  for (size_t i = 0; i < frames*AUDIO_CHANNELS; i++) {
+    x = x * 1664525 + 1013904223;  // 実行ごとに同じ系列にする
+    buffer16[i] = (int16_t)(x >> 18);
+    buffer32[i] = (int32_t)(x >> 2);
+    bufferFloat[i] = (int16_t)(x >> 16) / 32768.0f;
+  }
+}
+
+static void bench(uint8_t sections, uint8_t channels) {
+  // ローカット + ピーキング EQ を sections 段。サンプル数に段数を掛けて ns/sample/section を出す
+  BiquadCascade filter(AUDIO_SAMPLERATE);
+  filter.addHighPass(80);
+  for (uint8_t i = 1; i < sections; i++) {
+    filter.addPeaking(250.0f * i, 1.0f, 3.0f);
+  }
+  const size_t samples = frames * channels * sections;
+  char name[40];
+  snprintf(name, sizeof(name), "biquad float %ux%uch", sections, channels);
+  AudioBenchmark f(name, samples, frames * channels * sizeof(float));
+  f.run(BENCH_RUNS, [&]() { filter.process(AudioBlock<float>(bufferFloat, frames, channels)); });
+  f.report(Serial);
+  snprintf(name, sizeof(name), "biquad q31 %ux%uch", sections, channels);
+  AudioBenchmark q(name, samples, frames * channels * sizeof(int32_t));
+  q.run(BENCH_RUNS, [&]() { filter.process(AudioBlock<int32_t>(buffer32, frames, channels)); });
+  q.report(Serial);
+  snprintf(name, sizeof(name), "biquad int16 %ux%uch", sections, channels);
+  AudioBenchmark s(name, samples, frames * channels * sizeof(int16_t));
+  s.run(BENCH_RUNS, [&]() { filter.process(AudioBlock<int16_t>(buffer16, frames, channels)); });
+  s.report(Serial);
+}
+
+void setup() {
+  Serial.begin(115200);
+  fillNoise();
+}
+
+void loop() {
+  Serial.printf("# rate=%d msec=%d frames=%d cpu=%dMHz (ns/sample is per section)\n", AUDIO_SAMPLERATE, AUDIO_MSEC, (int)frames, (int)getCpuFrequencyMhz());
+  AudioBenchmark::printHeader(Serial);
+  for (uint8_t sections = 1; sections <= 4; sections <<= 1) {
+    bench(sections, 1);
+    bench(sections, AUDIO_CHANNELS);
+  }
+  delay(BENCH_INTERVAL_MSEC);
+}
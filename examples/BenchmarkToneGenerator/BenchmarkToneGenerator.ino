@@ -0,0 +1,53 @@
+#include <AudioBenchmark.h>
+#include <ToneGenerator.h>
+
+#define AUDIO_SAMPLERATE 8000  // Output/Input Audio sampling rate
+#define AUDIO_MSEC 20          // Payload time
+#define BENCH_RUNS 200         // Payloads per measurement
+#ifndef BENCH_INTERVAL_MSEC
+#define BENCH_INTERVAL_MSEC 5000  // Interval between reports (extras/host builds with 0)
+#endif
+
+static const size_t frames = AUDIO_SAMPLERATE*AUDIO_MSEC/1000;
+int16_t buffer[frames];
+ToneGenerator generator(AUDIO_SAMPLERATE);
+
+static void benchTone(const char* name) {
+  AudioBenchmark bench(name, frames, sizeof(buffer));
+  bench.run(BENCH_RUNS, []() { generator.render(buffer, frames); });
+  bench.report(Serial);
+}
+
+void setup() {
+  Serial.begin(115200);
+}
+
+void loop() {
+  static const int16_t frequency=440;
+  static const int16_t volume=32767;
+  static int s;
+
+  AudioBenchmark::printHeader(Serial);
+
+  // 従来の sin() による生成
+  AudioBenchmark bench("sin()", frames, sizeof(buffer));
+  bench.run(BENCH_RUNS, []() {
+    for(int i=0;i<frames;i++){
+      buffer[i]=(int16_t)(volume*sin(2.0 * M_PI * frequency*(s++)/AUDIO_SAMPLERATE));
+    }
+  });
+  bench.report(Serial);
+
+  generator.setTone(ToneGenerator::Sine, frequency, volume);
+  benchTone("dds sine");
+  generator.setTone(ToneGenerator::Square, frequency, volume);
+  benchTone("dds square");
+  generator.setTone(ToneGenerator::Triangle, frequency, volume);
+  benchTone("dds triangle");
+  generator.setDtmf('5', volume);
+  benchTone("dds dtmf");
+  generator.setSweep(ToneGenerator::Sine, 300, 3400, 1000, volume);
+  benchTone("dds sweep");
+
+  delay(BENCH_INTERVAL_MSEC);
+}
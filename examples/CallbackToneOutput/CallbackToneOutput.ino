@@ -0,0 +1,31 @@
+#include <Esp32BuiltinDacAudio.h>
+#include <ToneGenerator.h>
+
+#define AUDIO_SAMPLERATE 8000  // Output/Input Audio sampling rate
+#define AUDIO_BITRATE 16       // Output/Input Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#define AUDIO_MSEC 20         // DMA Buffer time
+#define AUDIO_BUFFER_COUNT 4  // DMA Buffer count
+
+Esp32BuiltinDacAudio audio(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, AUDIO_MSEC, AUDIO_BUFFER_COUNT);
+ToneGenerator generator(AUDIO_SAMPLERATE);
+
+// バッファに空きができたときだけ呼ばれる
+static void render(uint8_t* buffer, size_t frames, void* arg) {
+  static_cast<ToneGenerator*>(arg)->render((int16_t*)buffer, frames);
+}
+
+void setup() {
+  //UART
+  Serial.begin(115200);
+  audio.begin();
+  audio.start();
+  generator.setTone(ToneGenerator::Sine, 440, 32767);
+  audio.setRenderCallback(render, &generator);
+  log_d("start");
+}
+
+void loop() {
+  // availableForWrite() をポーリングせず、DMA イベントが来るまで待つ
+  audio.process();
+}
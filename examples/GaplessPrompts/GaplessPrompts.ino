@@ -0,0 +1,52 @@
+#include <Esp32BuiltinDacAudio.h>
+#include <PlaybackScheduler.h>
+#include <WavFileSource.h>
+#include <SD.h>
+
+#define AUDIO_SAMPLERATE 16000  // Output Audio sampling rate (WAV と一致させる)
+#define AUDIO_BITRATE 16        // Output Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#define AUDIO_MSEC 20           // DMA Buffer time
+#define AUDIO_BUFFER_COUNT 4    // DMA Buffer count
+#define PREFETCH_BLOCKS 8
+#define CROSSFADE_PERIODS 5     // skip() 時のクロスフェード (100ms)
+
+Esp32BuiltinDacAudio audio(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, AUDIO_MSEC, AUDIO_BUFFER_COUNT);
+WavFileSource first(audio, PREFETCH_BLOCKS);
+WavFileSource second(audio, PREFETCH_BLOCKS);
+WavFileSource music(audio, PREFETCH_BLOCKS);
+PlaybackScheduler scheduler(audio);
+
+static void render(uint8_t* buffer, size_t /*frames*/, void* arg) {
+  static_cast<PlaybackScheduler*>(arg)->read(buffer, audio.getPayloadSize());
+}
+
+void setup() {
+  Serial.begin(115200);
+  SD.begin();
+  audio.begin();
+  audio.start();
+  // プロンプト 2 本を隙間なく続けて再生し、その後に音楽を流す
+  first.open("/sd/prompt1.wav");
+  second.open("/sd/prompt2.wav");
+  music.open("/sd/music.wav");
+  scheduler.enqueue(&first);
+  scheduler.enqueue(&second);
+  scheduler.enqueue(&music);
+  audio.setRenderCallback(render, &scheduler);
+}
+
+void loop() {
+  audio.process();
+  if (Serial.available() && Serial.read() == 'n') {
+    // 次のソースがあれば、リングを捨てずにクロスフェードで切り替える
+    if (!scheduler.skip(CROSSFADE_PERIODS)) {
+      Serial.println("queue is empty");
+    }
+  }
+  static bool reported = false;
+  if (!reported && scheduler.finished()) {
+    reported = true;
+    Serial.printf("done, underflows %u\n", scheduler.getUnderflows());
+  }
+}
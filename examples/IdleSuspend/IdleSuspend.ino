@@ -0,0 +1,49 @@
+#include <Esp32BuiltinDacAudio.h>
+#include <ToneGenerator.h>
+
+// 短いビープを間隔を空けて鳴らし、無音の間は I2S を一時停止する。再開にかかった時間を表示する
+
+#define AUDIO_SAMPLERATE 16000  // Output Audio sampling rate
+#define AUDIO_BITRATE 16        // Output Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#define AUDIO_MSEC 20           // DMA Buffer time
+#define AUDIO_BUFFER_COUNT 4    // DMA Buffer count
+#define IDLE_SUSPEND_PERIODS 25 // 無音がこの周期数続いたら一時停止する (500msec)
+#define BEEP_MSEC 200
+#define BEEP_INTERVAL_MSEC 3000
+
+Esp32BuiltinDacAudio audio(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, AUDIO_MSEC, AUDIO_BUFFER_COUNT);
+ToneGenerator generator(AUDIO_SAMPLERATE);
+uint8_t buffer[AUDIO_SAMPLERATE*AUDIO_MSEC/1000*(AUDIO_BIT_LENGTH/8)];
+uint32_t beepStart = 0;
+bool suspended = false;
+
+void setup() {
+  Serial.begin(115200);
+  audio.begin();
+  audio.setIdleSuspend(IDLE_SUSPEND_PERIODS);
+  audio.start();
+  generator.setTone(ToneGenerator::Sine, 880, 16384);
+}
+
+void loop() {
+  const uint32_t now = millis();
+  if (now - beepStart >= BEEP_INTERVAL_MSEC) {
+    beepStart = now;
+  }
+  if (now - beepStart < BEEP_MSEC) {
+    // 一時停止中でも write() がそのまま再開する
+    if (audio.getPayloadSize() <= audio.availableForWrite()) {
+      generator.render((int16_t*)buffer, audio.getBufferLength());
+      audio.write((const uint8_t *)buffer, audio.getPayloadSize());
+    }
+  } else {
+    audio.availableForWrite();  // DMA イベントを処理して無音の周期を数える
+  }
+  if (suspended != audio.isSuspended()) {
+    suspended = audio.isSuspended();
+    Serial.printf("%s suspends=%u resume last=%uus max=%uus\n", suspended ? "suspend" : "resume ",
+      audio.getSuspendCount(), audio.getLastResumeMicros(), audio.getMaxResumeMicros());
+  }
+  delay(1);
+}
@@ -0,0 +1,91 @@
+#include <Esp32BuiltinDacAudio.h>
+#include <JitterBuffer.h>
+#include <ToneGenerator.h>
+
+#define AUDIO_SAMPLERATE 16000  // Output Audio sampling rate
+#define AUDIO_BITRATE 16        // Output Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#define AUDIO_MSEC 20           // DMA Buffer time
+#define AUDIO_BUFFER_COUNT 4    // DMA Buffer count
+#define AUDIO_FRAMES (AUDIO_SAMPLERATE * AUDIO_MSEC / 1000)
+#define JITTER_SLOTS 16
+#define LOSS_PERCENT 5          // 模擬ネットワークで捨てるパケットの割合
+#define MAX_DELAY_MSEC 60       // 模擬ネットワークの最大遅延 (到着順も入れ替わる)
+#define NETWORK_SLOTS 8
+
+Esp32BuiltinDacAudio audio(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, AUDIO_MSEC, AUDIO_BUFFER_COUNT);
+JitterBuffer jitter(audio, JITTER_SLOTS);
+ToneGenerator generator(AUDIO_SAMPLERATE);
+
+// 送信側で作ったパケットを、到着予定時刻まで抱えておく
+struct Packet {
+  bool used;
+  uint16_t sequence;
+  uint32_t timestamp;
+  uint32_t dueMsec;
+  int16_t data[AUDIO_FRAMES];
+};
+Packet network[NETWORK_SLOTS];
+uint16_t sendSequence = 0;
+uint32_t nextSendMsec = 0;
+
+static void render(uint8_t* buffer, size_t /*frames*/, void* arg) {
+  static_cast<JitterBuffer*>(arg)->read(buffer, audio.getPayloadSize());
+}
+
+static void sendPacket(uint32_t now) {
+  Packet* p = nullptr;
+  for (auto& slot : network) {
+    if (!slot.used) {
+      p = &slot;
+      break;
+    }
+  }
+  const uint16_t sequence = sendSequence++;
+  int16_t data[AUDIO_FRAMES];
+  generator.render(data, AUDIO_FRAMES);  // 捨てるパケットも音は進める
+  if (!p || random(100) < LOSS_PERCENT) {
+    return;
+  }
+  p->used = true;
+  p->sequence = sequence;
+  p->timestamp = (uint32_t)sequence * AUDIO_FRAMES;
+  p->dueMsec = now + random(MAX_DELAY_MSEC + 1);
+  memcpy(p->data, data, sizeof(data));
+}
+
+static void deliverPackets(uint32_t now) {
+  for (auto& slot : network) {
+    if (slot.used && (int32_t)(now - slot.dueMsec) >= 0) {
+      jitter.push(slot.sequence, slot.timestamp, reinterpret_cast<const uint8_t*>(slot.data), sizeof(slot.data));
+      slot.used = false;
+    }
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  audio.begin();
+  audio.start();
+  generator.setTone(ToneGenerator::Sine, 440, 16000);
+  audio.setRenderCallback(render, &jitter);
+  nextSendMsec = millis();
+}
+
+void loop() {
+  const uint32_t now = millis();
+  while ((int32_t)(now - nextSendMsec) >= 0) {
+    sendPacket(now);
+    nextSendMsec += AUDIO_MSEC;
+  }
+  deliverPackets(now);
+  audio.process(1);  // 模擬ネットワークを回すため 1msec で戻る
+
+  static uint32_t lastReportMsec = 0;
+  if (1000 <= now - lastReportMsec) {
+    lastReportMsec = now;
+    Serial.printf("jitter %uus depth %u/%u recv %u concealed %u late %u trimmed %u rebuffers %u\n",
+      jitter.getJitterMicros(), jitter.getDepth(), jitter.getTargetDepth(), jitter.getReceived(),
+      jitter.getConcealed(), jitter.getLate(), jitter.getTrimmed(), jitter.getRebuffers());
+  }
+}
@@ -0,0 +1,44 @@
+#include <Esp32BuiltinDacAudio.h>
+#include <WavFileSource.h>
+#include <SD.h>
+
+#define AUDIO_SAMPLERATE 16000  // Output Audio sampling rate (WAV と一致させる)
+#define AUDIO_BITRATE 16        // Output Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#define AUDIO_MSEC 20           // DMA Buffer time
+#define AUDIO_BUFFER_COUNT 4    // DMA Buffer count
+#define PREFETCH_BLOCKS 16      // SD の読み込み遅延 (最大 320ms) を隠すブロック数
+
+Esp32BuiltinDacAudio audio(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, AUDIO_MSEC, AUDIO_BUFFER_COUNT);
+WavFileSource source(audio, PREFETCH_BLOCKS);
+
+// 先読み済みのブロックをコピーするだけなので、SD が遅くても出力は止まらない
+static void render(uint8_t* buffer, size_t /*frames*/, void* arg) {
+  const size_t size = audio.getPayloadSize();
+  const size_t n = static_cast<WavFileSource*>(arg)->read(buffer, size);
+  memset(buffer + n, 0, size - n);
+}
+
+void setup() {
+  Serial.begin(115200);
+  SD.begin();
+  audio.begin();
+  audio.start();
+  if (!source.open("/sd/play.wav")) {
+    Serial.println("cannot play /sd/play.wav");
+    return;
+  }
+  audio.setRenderCallback(render, &source);
+}
+
+void loop() {
+  audio.process();
+  static bool reported = false;
+  if (!reported && source.finished()) {
+    reported = true;
+    audio.setRenderCallback(nullptr);
+    Serial.printf("max fetch %u us, hidden stalls %u, underflows %u\n",
+      source.getMaxFetchMicros(), source.getHiddenStalls(), source.getUnderflows());
+    source.close();
+  }
+}
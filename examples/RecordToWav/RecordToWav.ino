@@ -0,0 +1,52 @@
+#include <I2SAudio.h>
+#include <AudioRecorder.h>
+#include <SD.h>
+
+#define AUDIO_SAMPLERATE 16000  // Input Audio sampling rate
+#define AUDIO_BITRATE 16        // Input Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#define AUDIO_MSEC 20           // DMA Buffer time
+#define AUDIO_BUFFER_COUNT 4    // DMA Buffer count
+#define RECORD_BLOCKS 32        // SD の書き込み遅延 (最大 640ms) を吸収するブロック数
+#define RECORD_MSEC 30000
+
+I2SAudio mic(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, AUDIO_MSEC, 1, AUDIO_BUFFER_COUNT, {
+  .port = (i2s_port_t)0,
+  .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX),
+  .chFormat = I2S_CHANNEL_FMT_ONLY_LEFT,
+  .comFormat = I2S_COMM_FORMAT_STAND_I2S,
+  .txDescAutoClear = false,
+  .pinConfig = {
+    .bck_io_num = 26,
+    .ws_io_num = 25,
+    .data_out_num = -1,
+    .data_in_num = 33
+  },
+  .packed24Storage = false
+});
+AudioRecorder recorder(AUDIO_SAMPLERATE*AUDIO_MSEC/1000*(AUDIO_BIT_LENGTH/8), RECORD_BLOCKS);
+uint32_t startMsec;
+
+void setup() {
+  Serial.begin(115200);
+  SD.begin();
+  mic.begin();
+  mic.start();
+  recorder.open("/sd/record.wav", mic);
+  // 録音周期ごとにブロックを積むだけなので、SD が遅くても録音は止まらない
+  mic.setCaptureCallback(AudioRecorder::captureCallback, &recorder);
+  startMsec = millis();
+}
+
+void loop() {
+  if (recorder.isOpen()) {
+    mic.process();
+    if (RECORD_MSEC <= millis() - startMsec) {
+      mic.setCaptureCallback(nullptr);
+      recorder.close();
+      mic.stop();
+      Serial.printf("written %u blocks, dropped %u, %u bytes/s, max write %u us\n",
+        recorder.getWrittenBlocks(), recorder.getDroppedBlocks(), recorder.getThroughput(), recorder.getMaxWriteMicros());
+    }
+  }
+}
@@ -0,0 +1,119 @@
+#include <Esp32BuiltinDacAudio.h>
+#include <LoopBackAudio.h>
+#include <DummyAudio.h>
+#include <ToneGenerator.h>
+
+// バッファ設定ごとに、負荷と停止を注入しながら一定時間再生し、アンダーラン率と遅延を表にする
+
+#define AUDIO_SAMPLERATE 16000  // Output Audio sampling rate
+#define AUDIO_BITRATE 16        // Output Audio bit rate
+#define AUDIO_BIT_LENGTH 16
+#ifndef SOAK_MSEC
+#define SOAK_MSEC 10000         // 1 設定あたりの計測時間 (extras/host は短くしてビルドする)
+#endif
+#define STALL_PERCENT 5         // 周期ごとに停止を入れる確率 (%)
+#define STALL_MAX_MSEC 30       // 1 回の停止の最大時間
+#define LOAD_PERCENT 30         // 競合タスクの CPU 占有率 (%)
+#ifndef BENCH_INTERVAL_MSEC
+#define BENCH_INTERVAL_MSEC 60000  // Interval between reports (extras/host builds with 0)
+#endif
+
+static const uint16_t bufferMsecs[] = {5, 10, 20};
+static const uint8_t bufferCounts[] = {2, 4, 8};
+static const uint8_t ringFactors[] = {1, 2};  // ringBufferCount = bufferCount * factor
+
+ToneGenerator generator(AUDIO_SAMPLERATE);
+
+// 同じコアで一定割合 CPU を使い続ける競合タスク
+static void loadTask(void*) {
+  for (;;) {
+    const uint32_t start = millis();
+    while (millis() - start < LOAD_PERCENT / 10) {}
+    delay((100 - LOAD_PERCENT) / 10);
+  }
+}
+
+struct SoakResult {
+  uint32_t periods;
+  uint32_t underruns;
+  uint32_t stalls;
+  float latencyMsec;
+  float maxLatencyMsec;
+};
+
+static SoakResult soak(Audio& audio) {
+  SoakResult r = {};
+  uint8_t buffer[audio.getPayloadSize()];
+  uint64_t latencySum = 0;
+  uint32_t latencyMax = 0;
+  uint32_t baseUnderruns = 0;
+  randomSeed(1);  // 設定間で同じ停止パターンにする
+  audio.start();
+  const uint32_t start = millis();
+  while (millis() - start < SOAK_MSEC) {
+    if (!audio.waitForWritable()) {
+      continue;
+    }
+    if (random(100) < STALL_PERCENT) {
+      delay(random(STALL_MAX_MSEC));
+      r.stalls++;
+    }
+    generator.render((int16_t*)buffer, audio.getBufferLength());
+    audio.write(buffer, audio.getPayloadSize());
+    if (r.periods == 0) {
+      baseUnderruns = audio.getUnderrunCount();  // 最初の書き込みまでの空き (開始のランプ後など) は数えない
+    }
+    const uint32_t latency = audio.getOutputLatencyFrames();
+    latencySum += latency;
+    latencyMax = std::max(latencyMax, latency);
+    r.periods++;
+  }
+  r.underruns = audio.getUnderrunCount() - baseUnderruns;
+  audio.stop();
+  r.latencyMsec = r.periods ? 1000.0f * latencySum / r.periods / audio.getSampRate() : 0.0f;
+  r.maxLatencyMsec = 1000.0f * latencyMax / audio.getSampRate();
+  return r;
+}
+
+// hasLatency: getOutputLatencyFrames() を実装しているバックエンドだけ遅延を出す
+static void report(const char* backend, uint16_t msec, int count, int ring, bool hasLatency, const SoakResult& r) {
+  Serial.printf("%-10s %5u %5d %5d %8u %8u %7u %9.3f", backend, msec, count, ring,
+    r.periods, r.underruns, r.stalls, r.periods ? 100.0f * r.underruns / r.periods : 0.0f);
+  if (hasLatency) {
+    Serial.printf(" %9.1f %9.1f\n", r.latencyMsec, r.maxLatencyMsec);
+  } else {
+    Serial.printf(" %9s %9s\n", "-", "-");
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  generator.setTone(ToneGenerator::Sine, 440, 8000);
+  xTaskCreatePinnedToCore(loadTask, "load", 2048, nullptr, 1, nullptr, xPortGetCoreID());
+}
+
+void loop() {
+  Serial.printf("# stall=%d%% max %dms, load=%d%%, %d ms per row\n", STALL_PERCENT, STALL_MAX_MSEC, LOAD_PERCENT, SOAK_MSEC);
+  Serial.printf("%-10s %5s %5s %5s %8s %8s %7s %9s %9s %9s\n",
+    "backend", "msec", "count", "ring", "periods", "underrun", "stalls", "rate(%)", "lat(ms)", "maxlat");
+  for (uint16_t msec : bufferMsecs) {
+    for (uint8_t count : bufferCounts) {
+      for (uint8_t factor : ringFactors) {
+        Esp32BuiltinDacAudio* audio = new Esp32BuiltinDacAudio(AUDIO_SAMPLERATE, AUDIO_BITRATE, AUDIO_BIT_LENGTH, msec, count,
+          I2S_DAC_CHANNEL_RIGHT_EN, 0, {.port = (i2s_port_t)0, .pinConfig = {.bck_io_num = -1, .ws_io_num = -1, .data_out_num = -1, .data_in_num = -1}},
+          count * factor);
+        audio->begin();
+        report("i2s-dac", msec, count, count * factor, true, soak(*audio));
+        delete audio;
+      }
+    }
+    // LoopBack/Dummy はバッファ 1 本なので bufferMsec だけを振る
+    LoopBackAudio loopback(AUDIO_SAMPLERATE, AUDIO_BITRATE, msec, 1);
+    loopback.begin();
+    report("loopback", msec, 1, 1, false, soak(loopback));
+    DummyAudio dummy(AUDIO_SAMPLERATE, AUDIO_BITRATE, msec, 1);
+    dummy.begin();
+    report("dummy", msec, 1, 1, false, soak(dummy));
+  }
+  delay(BENCH_INTERVAL_MSEC);
+}
@@ -0,0 +1,15 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+// examples/BenchmarkKernels をそのままホストで 1 周だけ動かす
+
+#include <Arduino.h>  // Arduino IDE と同じく、スケッチの前に読み込む
+#include "../../examples/BenchmarkKernels/BenchmarkKernels.ino"
+
+int main() {
+  setup();
+  loop();
+  return 0;
+}
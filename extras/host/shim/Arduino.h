@@ -0,0 +1,57 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_ARDUINO_H_
+#define LIB_ARDUINO_AUDIO_HOST_ARDUINO_H_
+
+// ホスト (Linux) でライブラリをビルドするための最小限の Arduino API。時刻は CLOCK_MONOTONIC
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#define log_e(format, ...) fprintf(stderr, "[E] " format "\n", ##__VA_ARGS__)
+#define log_w(format, ...) fprintf(stderr, "[W] " format "\n", ##__VA_ARGS__)
+#define log_i(format, ...) ((void)0)
+#define log_d(format, ...) ((void)0)
+#define log_v(format, ...) ((void)0)
+
+std::uint32_t millis();
+std::uint32_t micros();
+void delay(std::uint32_t ms);
+void delayMicroseconds(std::uint32_t us);
+void yield();
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+std::uint32_t getCpuFrequencyMhz();  ///< ホストでは 0
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual std::size_t write(const std::uint8_t* buffer, std::size_t size) = 0;
+  std::size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  std::size_t print(const char* s);
+  std::size_t println(const char* s = "");
+};
+
+/**
+ * @brief stdout へ書く Serial
+ */
+class HostSerial : public Print {
+ public:
+  void begin(unsigned long /*baud*/) {}
+  std::size_t write(const std::uint8_t* buffer, std::size_t size) override;
+};
+
+extern HostSerial Serial;
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_ARDUINO_H_
@@ -0,0 +1,410 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "Arduino.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/i2s.h"
+#include <stdarg.h>
+#include <time.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+HostSerial Serial;
+
+static std::uint64_t monotonicMicros() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (std::uint64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+}
+
+static const std::uint64_t bootMicros = monotonicMicros();
+
+std::uint32_t millis() {
+  return (std::uint32_t)((monotonicMicros() - bootMicros) / 1000);
+}
+
+std::uint32_t micros() {
+  return (std::uint32_t)(monotonicMicros() - bootMicros);
+}
+
+void delayMicroseconds(std::uint32_t us) {
+  const struct timespec t = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+  nanosleep(&t, nullptr);
+}
+
+void delay(std::uint32_t ms) {
+  delayMicroseconds(ms * 1000);
+}
+
+void yield() {
+}
+
+long random(long howbig) {
+  return howbig <= 0 ? 0 : rand() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  srand((unsigned)seed);
+}
+
+std::uint32_t getCpuFrequencyMhz() {
+  return 0;
+}
+
+std::size_t Print::printf(const char* format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  const int n = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (n <= 0) {
+    return 0;
+  }
+  return write(reinterpret_cast<const std::uint8_t*>(buffer), std::min<std::size_t>(n, sizeof(buffer) - 1));
+}
+
+std::size_t Print::print(const char* s) {
+  return write(reinterpret_cast<const std::uint8_t*>(s), strlen(s));
+}
+
+std::size_t Print::println(const char* s) {
+  return print(s) + print("\n");
+}
+
+std::size_t HostSerial::write(const std::uint8_t* buffer, std::size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+// FreeRTOS
+
+struct HostQueue {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::vector<std::uint8_t>> items;
+  UBaseType_t length;
+  UBaseType_t itemSize;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  HostQueue* queue = new HostQueue();
+  queue->length = length;
+  queue->itemSize = itemSize;
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+/**
+ * @brief ready() が true になるまで最大 ticksToWait 待つ。I2S の DMA を進めるため、1 msec ごとに起きる
+ */
+template<class F>
+static bool waitQueue(QueueHandle_t queue, std::unique_lock<std::mutex>& lock, TickType_t ticksToWait, F ready) {
+  const std::uint32_t start = millis();
+  for (;;) {
+    if (ready()) {
+      return true;
+    }
+    if (ticksToWait <= millis() - start) {
+      return false;
+    }
+    queue->changed.wait_for(lock, std::chrono::milliseconds(1));
+    lock.unlock();
+    hostI2sAdvance();
+    lock.lock();
+  }
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!waitQueue(queue, lock, ticksToWait, [queue]() { return queue->items.size() < queue->length; })) {
+    return pdFALSE;
+  }
+  const std::uint8_t* p = static_cast<const std::uint8_t*>(item);
+  queue->items.emplace_back(p, p + (p ? queue->itemSize : 0));
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+static BaseType_t receive(QueueHandle_t queue, void* item, TickType_t ticksToWait, bool remove) {
+  hostI2sAdvance();
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!waitQueue(queue, lock, ticksToWait, [queue]() { return !queue->items.empty(); })) {
+    return pdFALSE;
+  }
+  if (item && queue->itemSize) {
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+  }
+  if (remove) {
+    queue->items.pop_front();
+    queue->changed.notify_all();
+  }
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+  return receive(queue, item, ticksToWait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+  return receive(queue, item, ticksToWait, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  queue->items.clear();
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  hostI2sAdvance();
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->items.size();
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char*, std::uint32_t, void* arg, UBaseType_t, TaskHandle_t* handle) {
+  std::thread(task, arg).detach();
+  if (handle) {
+    *handle = nullptr;
+  }
+  return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, std::uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle, BaseType_t) {
+  return xTaskCreate(task, name, stackDepth, arg, priority, handle);
+}
+
+BaseType_t xPortGetCoreID() {
+  return 0;
+}
+
+void vTaskDelete(TaskHandle_t) {
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks);
+}
+
+void vTaskSuspendAll() {
+}
+
+BaseType_t xTaskResumeAll() {
+  return pdFALSE;
+}
+
+// I2S
+
+struct HostI2sPort {
+  bool installed;
+  bool running;
+  i2s_config_t config;
+  QueueHandle_t queue;
+  std::size_t frameBytes;
+  std::uint64_t epochMicros;  ///< i2s_start() した時刻
+  std::uint64_t doneBuffers;  ///< epochMicros から送出し終えた DMA バッファ数
+  std::uint32_t txFrames;     ///< DMA に積まれている送出待ちのフレーム数
+  std::uint32_t rxFrames;     ///< DMA に溜まっている録音済みのフレーム数
+};
+
+static HostI2sPort ports[I2S_NUM_MAX];
+static std::recursive_mutex i2sMutex;  ///< 書き込みタスクなど別スレッドからのキュー待ちでも DMA を進めるため
+
+static std::size_t frameBytesOf(std::uint32_t bits, std::uint32_t channels) {
+  const std::uint32_t bytes = ((bits & 0xFFFF) + 7) / 8;
+  return (bytes == 3 ? 4 : bytes) * channels;
+}
+
+static std::uint32_t channelsOf(i2s_channel_fmt_t format) {
+  return (format == I2S_CHANNEL_FMT_ONLY_LEFT || format == I2S_CHANNEL_FMT_ONLY_RIGHT) ? 1 : 2;
+}
+
+static void postEvent(HostI2sPort& p, i2s_event_type_t type) {
+  if (!p.queue) {
+    return;
+  }
+  if (p.queue->length <= p.queue->items.size()) {
+    p.queue->items.pop_front();  // ドライバと同じく古いイベントを捨てる
+  }
+  const i2s_event_t event = {type, (std::size_t)p.config.dma_buf_len * p.frameBytes};
+  xQueueSend(p.queue, &event, 0);
+}
+
+void hostI2sAdvance() {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  const std::uint64_t now = monotonicMicros();
+  for (HostI2sPort& p : ports) {
+    if (!p.installed || !p.running || p.config.dma_buf_len <= 0) {
+      continue;
+    }
+    const std::uint64_t frames = (now - p.epochMicros) * (std::uint64_t)p.config.sample_rate / 1000000;
+    const std::uint64_t buffers = frames / (std::uint64_t)p.config.dma_buf_len;
+    const std::uint32_t capacity = (std::uint32_t)p.config.dma_buf_count * p.config.dma_buf_len;
+    for (; p.doneBuffers < buffers; p.doneBuffers++) {
+      if ((std::uint8_t)p.config.mode & (std::uint8_t)I2S_MODE_TX) {
+        p.txFrames -= std::min<std::uint32_t>(p.txFrames, p.config.dma_buf_len);
+        postEvent(p, I2S_EVENT_TX_DONE);
+      }
+      if ((std::uint8_t)p.config.mode & (std::uint8_t)I2S_MODE_RX) {
+        p.rxFrames = std::min<std::uint32_t>(capacity, p.rxFrames + p.config.dma_buf_len);
+        postEvent(p, I2S_EVENT_RX_DONE);
+      }
+    }
+  }
+}
+
+static HostI2sPort* getPort(i2s_port_t port) {
+  if (port < 0 || I2S_NUM_MAX <= port || !ports[port].installed) {
+    return nullptr;
+  }
+  return &ports[port];
+}
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* config, int queueSize, QueueHandle_t* queue) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  if (port < 0 || I2S_NUM_MAX <= port || ports[port].installed) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  HostI2sPort& p = ports[port];
+  p = HostI2sPort();
+  p.installed = true;
+  p.config = *config;
+  p.frameBytes = frameBytesOf(config->bits_per_sample, channelsOf(config->channel_format));
+  if (queue) {
+    p.queue = xQueueCreate(queueSize, sizeof(i2s_event_t));
+    *queue = p.queue;
+  }
+  p.running = true;  // ドライバはインストール直後から動く
+  p.epochMicros = monotonicMicros();
+  return ESP_OK;
+}
+
+esp_err_t i2s_driver_uninstall(i2s_port_t port) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (p->queue) {
+    vQueueDelete(p->queue);
+  }
+  *p = HostI2sPort();
+  return ESP_OK;
+}
+
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t*) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  return getPort(port) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t i2s_set_dac_mode(i2s_dac_mode_t) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  return ESP_OK;
+}
+
+esp_err_t i2s_start(i2s_port_t port) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!p->running) {
+    p->running = true;
+    p->epochMicros = monotonicMicros();
+    p->doneBuffers = 0;
+  }
+  return ESP_OK;
+}
+
+esp_err_t i2s_stop(i2s_port_t port) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  hostI2sAdvance();
+  p->running = false;
+  return ESP_OK;
+}
+
+esp_err_t i2s_set_clk(i2s_port_t port, std::uint32_t rate, std::uint32_t bits, i2s_channel_t ch) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  // レガシードライバと同じく、止めて設定し直し、DMA をクリアしてから再び動かす
+  i2s_stop(port);
+  p->config.sample_rate = rate;
+  p->frameBytes = frameBytesOf(bits, ch);
+  i2s_zero_dma_buffer(port);
+  return i2s_start(port);
+}
+
+esp_err_t i2s_zero_dma_buffer(i2s_port_t port) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  p->txFrames = 0;
+  p->rxFrames = 0;
+  return ESP_OK;
+}
+
+esp_err_t i2s_write(i2s_port_t port, const void* /*src*/, std::size_t size, std::size_t* bytesWritten, TickType_t ticksToWait) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p || p->frameBytes == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  const std::uint32_t capacity = (std::uint32_t)p->config.dma_buf_count * p->config.dma_buf_len;
+  const std::uint32_t start = millis();
+  std::size_t written = 0;
+  for (;;) {
+    hostI2sAdvance();
+    const std::size_t frames = std::min<std::size_t>((size - written) / p->frameBytes, capacity - p->txFrames);
+    p->txFrames += frames;
+    written += frames * p->frameBytes;
+    if (size - written < p->frameBytes || ticksToWait <= millis() - start || !p->running) {
+      break;
+    }
+    delayMicroseconds(100);
+  }
+  *bytesWritten = written;
+  return ESP_OK;
+}
+
+esp_err_t i2s_read(i2s_port_t port, void* dest, std::size_t size, std::size_t* bytesRead, TickType_t ticksToWait) {
+  std::lock_guard<std::recursive_mutex> lock(i2sMutex);
+  HostI2sPort* p = getPort(port);
+  if (!p || p->frameBytes == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  const std::uint32_t start = millis();
+  std::size_t read = 0;
+  for (;;) {
+    hostI2sAdvance();
+    const std::size_t frames = std::min<std::size_t>((size - read) / p->frameBytes, p->rxFrames);
+    memset(static_cast<std::uint8_t*>(dest) + read, 0, frames * p->frameBytes);
+    p->rxFrames -= frames;
+    read += frames * p->frameBytes;
+    if (size - read < p->frameBytes || ticksToWait <= millis() - start || !p->running) {
+      break;
+    }
+    delayMicroseconds(100);
+  }
+  *bytesRead = read;
+  return ESP_OK;
+}
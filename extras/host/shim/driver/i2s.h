@@ -0,0 +1,121 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_I2S_H_
+#define LIB_ARDUINO_AUDIO_HOST_I2S_H_
+
+// レガシー I2S ドライバの模擬。DMA は実時間 (CLOCK_MONOTONIC) でサンプリング周波数どおりに消費され、
+// DMA バッファ 1 本ごとに TX_DONE/RX_DONE をイベントキューへ積む。送出データは捨て、録音データは 0
+
+#include "../freertos/FreeRTOS.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERROR_CHECK(x) do { esp_err_t err_ = (x); if (err_ != ESP_OK) { fprintf(stderr, "ESP_ERROR_CHECK failed: %d\n", err_); abort(); } } while (0)
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+
+typedef enum {
+  I2S_NUM_0 = 0,
+  I2S_NUM_1 = 1,
+  I2S_NUM_MAX,
+} i2s_port_t;
+
+typedef enum {
+  I2S_MODE_MASTER = 1 << 0,
+  I2S_MODE_SLAVE = 1 << 1,
+  I2S_MODE_TX = 1 << 2,
+  I2S_MODE_RX = 1 << 3,
+  I2S_MODE_DAC_BUILT_IN = 1 << 4,
+  I2S_MODE_ADC_BUILT_IN = 1 << 5,
+  I2S_MODE_PDM = 1 << 6,
+} i2s_mode_t;
+
+typedef enum {
+  I2S_BITS_PER_SAMPLE_8BIT = 8,
+  I2S_BITS_PER_SAMPLE_16BIT = 16,
+  I2S_BITS_PER_SAMPLE_24BIT = 24,
+  I2S_BITS_PER_SAMPLE_32BIT = 32,
+} i2s_bits_per_sample_t;
+
+typedef enum {
+  I2S_CHANNEL_FMT_RIGHT_LEFT,
+  I2S_CHANNEL_FMT_ALL_RIGHT,
+  I2S_CHANNEL_FMT_ALL_LEFT,
+  I2S_CHANNEL_FMT_ONLY_RIGHT,
+  I2S_CHANNEL_FMT_ONLY_LEFT,
+} i2s_channel_fmt_t;
+
+typedef enum {
+  I2S_COMM_FORMAT_STAND_I2S = 0x01,
+  I2S_COMM_FORMAT_STAND_MSB = 0x02,
+  I2S_COMM_FORMAT_I2S = 0x01,
+  I2S_COMM_FORMAT_I2S_MSB = 0x01,
+} i2s_comm_format_t;
+
+typedef enum {
+  I2S_CHANNEL_MONO = 1,
+  I2S_CHANNEL_STEREO = 2,
+} i2s_channel_t;
+
+typedef enum {
+  I2S_DAC_CHANNEL_DISABLE = 0,
+  I2S_DAC_CHANNEL_RIGHT_EN = 1,
+  I2S_DAC_CHANNEL_LEFT_EN = 2,
+  I2S_DAC_CHANNEL_BOTH_EN = 3,
+} i2s_dac_mode_t;
+
+typedef enum {
+  I2S_EVENT_DMA_ERROR,
+  I2S_EVENT_TX_DONE,
+  I2S_EVENT_RX_DONE,
+} i2s_event_type_t;
+
+typedef struct {
+  i2s_event_type_t type;
+  std::size_t size;
+} i2s_event_t;
+
+typedef struct {
+  int bck_io_num;
+  int ws_io_num;
+  int data_out_num;
+  int data_in_num;
+} i2s_pin_config_t;
+
+typedef struct {
+  i2s_mode_t mode;
+  int sample_rate;
+  i2s_bits_per_sample_t bits_per_sample;
+  i2s_channel_fmt_t channel_format;
+  i2s_comm_format_t communication_format;
+  int intr_alloc_flags;
+  int dma_buf_count;
+  int dma_buf_len;
+  bool tx_desc_auto_clear;
+} i2s_config_t;
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* config, int queueSize, QueueHandle_t* queue);
+esp_err_t i2s_driver_uninstall(i2s_port_t port);
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t* pin);
+esp_err_t i2s_set_dac_mode(i2s_dac_mode_t mode);
+esp_err_t i2s_set_clk(i2s_port_t port, std::uint32_t rate, std::uint32_t bits, i2s_channel_t ch);
+esp_err_t i2s_start(i2s_port_t port);
+esp_err_t i2s_stop(i2s_port_t port);
+esp_err_t i2s_zero_dma_buffer(i2s_port_t port);
+esp_err_t i2s_write(i2s_port_t port, const void* src, std::size_t size, std::size_t* bytesWritten, TickType_t ticksToWait);
+esp_err_t i2s_read(i2s_port_t port, void* dest, std::size_t size, std::size_t* bytesRead, TickType_t ticksToWait);
+
+/**
+ * @brief 経過時間ぶん DMA を進める。キューを覗く前に呼ばれる
+ */
+void hostI2sAdvance();
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_I2S_H_
@@ -0,0 +1,22 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_RTC_IO_H_
+#define LIB_ARDUINO_AUDIO_HOST_RTC_IO_H_
+
+typedef int gpio_num_t;
+typedef enum {
+  RTC_GPIO_MODE_INPUT_ONLY,
+  RTC_GPIO_MODE_OUTPUT_ONLY,
+  RTC_GPIO_MODE_INPUT_OUTPUT,
+  RTC_GPIO_MODE_DISABLED,
+} rtc_gpio_mode_t;
+
+inline int rtc_gpio_init(gpio_num_t) { return 0; }
+inline int rtc_gpio_deinit(gpio_num_t) { return 0; }
+inline int rtc_gpio_set_direction(gpio_num_t, rtc_gpio_mode_t) { return 0; }
+inline int rtc_gpio_set_level(gpio_num_t, std::uint32_t) { return 0; }
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_RTC_IO_H_
@@ -0,0 +1,11 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_ESP32_HAL_H_
+#define LIB_ARDUINO_AUDIO_HOST_ESP32_HAL_H_
+
+#include "Arduino.h"
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_ESP32_HAL_H_
@@ -0,0 +1,17 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_ESP_HEAP_CAPS_H_
+#define LIB_ARDUINO_AUDIO_HOST_ESP_HEAP_CAPS_H_
+
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT   (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+
+inline void* heap_caps_malloc(std::size_t size, std::uint32_t /*caps*/) { return malloc(size); }
+inline void heap_caps_free(void* p) { free(p); }
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_ESP_HEAP_CAPS_H_
@@ -0,0 +1,48 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_FREERTOS_H_
+#define LIB_ARDUINO_AUDIO_HOST_FREERTOS_H_
+
+// キューとセマフォは mutex/condition_variable、タスクは std::thread で模擬する。優先度とスタックサイズは無視する
+
+#include <cstddef>
+#include <cstdint>
+
+typedef std::uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+struct HostQueue;
+typedef HostQueue* QueueHandle_t;
+typedef HostQueue* xQueueHandle;
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+BaseType_t xQueueReset(QueueHandle_t queue);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, std::uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, std::uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle, BaseType_t coreId);  ///< coreId は無視する
+BaseType_t xPortGetCoreID();  ///< 常に 0
+void vTaskDelete(TaskHandle_t task);  ///< タスク関数の末尾で自分を消す使い方だけに対応する (何もしない)
+void vTaskDelay(TickType_t ticks);
+void vTaskSuspendAll();
+BaseType_t xTaskResumeAll();
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_FREERTOS_H_
@@ -0,0 +1,22 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_HOST_SEMPHR_H_
+#define LIB_ARDUINO_AUDIO_HOST_SEMPHR_H_
+
+#include "FreeRTOS.h"
+
+// FreeRTOS と同じく、セマフォは要素サイズ 0、長さ 1 のキュー
+
+typedef QueueHandle_t SemaphoreHandle_t;
+typedef QueueHandle_t xSemaphoreHandle;
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { return xQueueSend(s, nullptr, 0); }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticksToWait) { return xQueueReceive(s, nullptr, ticksToWait); }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return xQueueCreate(1, 0); }
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { SemaphoreHandle_t s = xQueueCreate(1, 0); xSemaphoreGive(s); return s; }
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { vQueueDelete(s); }
+
+#endif  // LIB_ARDUINO_AUDIO_HOST_SEMPHR_H_
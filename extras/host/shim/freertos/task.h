@@ -0,0 +1,6 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "FreeRTOS.h"
@@ -0,0 +1,54 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+// AudioRecorder をホストの POSIX ファイルへ書き、書き込みタスク経由で全周期が残ることを確かめる
+
+#include <AudioRecorder.h>
+#include <DummyAudio.h>
+#include <Arduino.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define EXPECT(cond) do { if (!(cond)) { fprintf(stderr, "%s:%d: EXPECT(%s)\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+int main() {
+  DummyAudio audio(16000, 16, 20, 1);
+  const std::size_t payload = audio.getPayloadSize();
+  const int periods = 50;
+  char path[] = "/tmp/AudioRecorderTestXXXXXX";
+  const int fd = mkstemp(path);
+  EXPECT(0 <= fd);
+  close(fd);
+
+  AudioRecorder recorder(payload, 8);
+  EXPECT(recorder.open(path, audio));
+  std::uint8_t block[payload];
+  for (int i = 0; i < periods; i++) {
+    memset(block, i, payload);
+    EXPECT(recorder.push(block, payload));
+    delay(1);  // 書き込みタスクが追いつく程度の周期
+  }
+  recorder.close();
+  EXPECT(recorder.getWrittenBlocks() == (std::uint32_t)periods);
+  EXPECT(recorder.getDroppedBlocks() == 0);
+  EXPECT(recorder.getWrittenBytes() == (std::uint64_t)periods * payload);
+
+  FILE* file = fopen(path, "rb");
+  EXPECT(file);
+  WavHeader header;
+  EXPECT(header.read(file));
+  EXPECT(header.sampleRate == 16000 && header.channels == 1 && header.bitsPerSample == 16);
+  EXPECT(header.dataBytes == periods * payload);
+  for (int i = 0; i < periods; i++) {
+    EXPECT(fread(block, 1, payload, file) == payload);
+    EXPECT(block[0] == (std::uint8_t)i && block[payload - 1] == (std::uint8_t)i);
+  }
+  fclose(file);
+  unlink(path);
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+// 欠落、入れ替わり、到着揺らぎのある模擬ストリームを JitterBuffer に通し、
+// シーケンス番号が 65535 から 0 へ一巡しても、届いた周期を順番どおり一度ずつ再生することを確かめる。
+// 溜め直しの後に再生済みの周期が届いても、先頭を巻き戻さずに遅着として捨てることも確かめる
+
+#include <JitterBuffer.h>
+#include <DummyAudio.h>
+#include <Arduino.h>
+#include <algorithm>
+#include <vector>
+
+static int failures = 0;
+
+#define EXPECT(cond) do { if (!(cond)) { fprintf(stderr, "%s:%d: EXPECT(%s)\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+static const std::uint32_t PeriodMicros = 10000;
+static const std::uint16_t FirstSequence = 65400;  // 136 周期目で一巡する
+static const int PacketCount = 300;
+static const std::int32_t Marker = 1 << 28;       ///< L チャンネル。ゲインの大きさを測る
+static const int IndexShift = 16;                 ///< R チャンネルにパケット番号を入れる
+
+struct Packet {
+  int index;
+  std::uint32_t arrivalMicros;
+};
+
+/**
+ * @brief 9 個に 1 個を落とし、13 個に 1 個を次のパケットより遅らせ、0〜6 msec の揺らぎを乗せる
+ */
+static std::vector<Packet> simulateNetwork() {
+  std::vector<Packet> packets;
+  std::uint32_t lcg = 12345;
+  for (int k = 0; k < PacketCount; k++) {
+    lcg = lcg * 1103515245 + 12345;
+    if (k % 9 == 4) {
+      continue;
+    }
+    std::uint32_t arrival = k * PeriodMicros + (lcg >> 16) % 6000;
+    if (k % 13 == 6) {
+      arrival += PeriodMicros + 6000;
+    }
+    packets.push_back({k, arrival});
+  }
+  std::stable_sort(packets.begin(), packets.end(), [](const Packet& a, const Packet& b) {
+    return a.arrivalMicros < b.arrivalMicros;
+  });
+  return packets;
+}
+
+/**
+ * @brief L チャンネルに Marker、R チャンネルにパケット番号を入れた 1 周期を作る
+ */
+static void fillPayload(std::int32_t* payload, std::size_t frames, int k) {
+  for (std::size_t i = 0; i < frames; i++) {
+    payload[i * 2] = Marker;
+    payload[i * 2 + 1] = k << IndexShift;
+  }
+}
+
+static void testLossyStream() {
+  DummyAudio output(16000, 32, 10, 2);
+  JitterBuffer jitter(output, 12, 8);  // 2 の累乗でない指定は 16 に切り上がる。一巡の前後を同時に溜める深さにする
+  const std::size_t frames = output.getBufferLength();
+  const std::vector<Packet> packets = simulateNetwork();
+
+  std::vector<int> played;
+  std::size_t next = 0;
+  std::int32_t block[frames * 2];
+  for (int period = 0; period < PacketCount + 20; period++) {
+    const std::uint32_t now = 30000 + period * PeriodMicros;
+    while (next < packets.size() && packets[next].arrivalMicros <= now) {
+      const int k = packets[next].index;
+      std::int32_t payload[frames * 2];
+      fillPayload(payload, frames, k);
+      EXPECT(jitter.push((std::uint16_t)(FirstSequence + k), k * frames,
+                         reinterpret_cast<const std::uint8_t*>(payload), sizeof(payload), packets[next].arrivalMicros));
+      next++;
+    }
+    if (next == packets.size()) {
+      jitter.setEndOfStream();
+    }
+    EXPECT(jitter.read(reinterpret_cast<std::uint8_t*>(block), sizeof(block)) == sizeof(block));
+    const std::int32_t level = block[(frames - 1) * 2];
+    if (Marker - Marker / 64 < level) {
+      // 補間中の周期は末尾で 3/4 以下まで絞られているので、ほぼ等倍なら受信した周期
+      const std::int64_t k = ((std::int64_t)block[(frames - 1) * 2 + 1] * (Marker >> IndexShift) + level / 2) / level;
+      played.push_back((int)k);
+    }
+  }
+
+  EXPECT(jitter.finished());
+  EXPECT(jitter.getReceived() == packets.size());
+  EXPECT(jitter.getLate() == 0);
+  EXPECT(jitter.getDuplicates() == 0);
+  EXPECT(jitter.getOverflows() == 0);
+  EXPECT(0 < jitter.getConcealed());
+  EXPECT(played.size() + jitter.getTrimmed() >= packets.size());
+  for (std::size_t i = 1; i < played.size(); i++) {
+    EXPECT(played[i - 1] < played[i]);  // 並べ替え済みで、同じ周期を二度出さない
+  }
+  EXPECT(!played.empty() && played.front() < 65536 - FirstSequence && 65536 - FirstSequence < played.back());
+}
+
+/**
+ * @brief 0, 1 を再生して途切れ、溜め直しに入ってから 10 と、1 の再送が届く
+ */
+static void testLateAfterRebuffer() {
+  DummyAudio output(16000, 32, 10, 2);
+  JitterBuffer jitter(output, 16, 1);
+  const std::size_t frames = output.getBufferLength();
+  std::int32_t payload[frames * 2];
+  std::int32_t block[frames * 2];
+  std::uint8_t* const out = reinterpret_cast<std::uint8_t*>(block);
+  for (int k = 0; k < 2; k++) {
+    fillPayload(payload, frames, k);
+    EXPECT(jitter.push(k, k * frames, reinterpret_cast<const std::uint8_t*>(payload), sizeof(payload), k * PeriodMicros));
+    EXPECT(jitter.read(out, sizeof(block)) == sizeof(block));
+    EXPECT(block[(frames - 1) * 2 + 1] == k << IndexShift);
+  }
+  for (int i = 0; i < JitterBuffer::FadePeriods; i++) {
+    EXPECT(jitter.read(out, sizeof(block)) == sizeof(block));
+  }
+  EXPECT(!jitter.isPlaying() && jitter.getRebuffers() == 1);
+  const std::uint32_t concealed = jitter.getConcealed();
+
+  fillPayload(payload, frames, 10);
+  EXPECT(jitter.push(10, 10 * frames, reinterpret_cast<const std::uint8_t*>(payload), sizeof(payload), 10 * PeriodMicros));
+  const std::uint32_t jitterMicros = jitter.getJitterMicros();
+  fillPayload(payload, frames, 1);
+  EXPECT(!jitter.push(1, 1 * frames, reinterpret_cast<const std::uint8_t*>(payload), sizeof(payload), 10 * PeriodMicros));
+  EXPECT(jitter.getLate() == 1);
+  EXPECT(jitter.getDuplicates() == 0);
+  EXPECT(jitter.getJitterMicros() == jitterMicros);
+
+  // 先頭は 10 のままで、2〜9 を補間せずに 10 を再生する
+  EXPECT(jitter.read(out, sizeof(block)) == sizeof(block));
+  const std::int32_t level = block[(frames - 1) * 2];
+  EXPECT(0 < level && ((std::int64_t)block[(frames - 1) * 2 + 1] * (Marker >> IndexShift) + level / 2) / level == 10);
+  EXPECT(jitter.getConcealed() == concealed);
+}
+
+int main() {
+  testLossyStream();
+  testLateAfterRebuffer();
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
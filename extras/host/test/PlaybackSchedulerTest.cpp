@@ -0,0 +1,124 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+// PlaybackScheduler がソースの継ぎ目をフレーム単位で詰めて出すこと、
+// クロスフェードが単調に進み、その間の skip() を受け付けないことを確かめる
+
+#include <PlaybackScheduler.h>
+#include <DummyAudio.h>
+#include <Arduino.h>
+
+static int failures = 0;
+
+#define EXPECT(cond) do { if (!(cond)) { fprintf(stderr, "%s:%d: EXPECT(%s)\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+/**
+ * @brief first から 1 ずつ増える値を length フレーム出す 16bit モノラルのソース
+ */
+class CountSource : public AudioSource {
+ public:
+  CountSource(std::int16_t first, std::size_t length) : next(first), remaining(length) {}
+
+  std::size_t read(std::uint8_t* buffer, std::size_t byteLength) override {
+    std::int16_t* out = reinterpret_cast<std::int16_t*>(buffer);
+    std::size_t n = 0;
+    while (n < byteLength / 2 && 0 < remaining) {
+      out[n++] = next++;
+      remaining--;
+    }
+    return n * 2;
+  }
+
+  bool finished() const override {
+    return remaining == 0;
+  }
+
+ private:
+  std::int16_t next;
+  std::size_t remaining;
+};
+
+/**
+ * @brief 一定値を出し続ける 16bit モノラルのソース
+ */
+class ConstantSource : public AudioSource {
+ public:
+  explicit ConstantSource(std::int16_t value) : value(value) {}
+
+  std::size_t read(std::uint8_t* buffer, std::size_t byteLength) override {
+    std::int16_t* out = reinterpret_cast<std::int16_t*>(buffer);
+    for (std::size_t i = 0; i < byteLength / 2; i++) {
+      out[i] = value;
+    }
+    return byteLength;
+  }
+
+  bool finished() const override {
+    return false;
+  }
+
+ private:
+  const std::int16_t value;
+};
+
+static void testGaplessJoins(const Audio& output) {
+  PlaybackScheduler scheduler(output);
+  CountSource a(0, 13);
+  CountSource b(13, 5);
+  CountSource c(18, 100);
+  EXPECT(scheduler.enqueue(&a));
+  EXPECT(scheduler.enqueue(&b));
+  EXPECT(scheduler.enqueue(&c));
+  const std::size_t frames = output.getBufferLength();
+  std::int16_t block[frames];
+  EXPECT(scheduler.read(reinterpret_cast<std::uint8_t*>(block), sizeof(block)) == 118 * 2);
+  for (std::size_t i = 0; i < frames; i++) {
+    EXPECT(block[i] == (i < 118 ? (std::int16_t)i : 0));  // 継ぎ目に隙間も重なりもない
+  }
+  EXPECT(scheduler.finished());
+  EXPECT(scheduler.getUnderflows() == 0);
+}
+
+static void testCrossfade(const Audio& output) {
+  PlaybackScheduler scheduler(output);
+  ConstantSource first(-16000);
+  ConstantSource second(16000);
+  ConstantSource third(0);
+  EXPECT(scheduler.enqueue(&first));
+  EXPECT(scheduler.enqueue(&second));
+  EXPECT(scheduler.enqueue(&third));
+  const std::size_t frames = output.getBufferLength();
+  std::int16_t block[frames];
+  EXPECT(scheduler.read(reinterpret_cast<std::uint8_t*>(block), sizeof(block)) == sizeof(block));
+  EXPECT(block[0] == -16000);
+
+  EXPECT(scheduler.skip(2));
+  EXPECT(scheduler.isCrossfading());
+  std::int16_t previous = -16000;
+  for (int period = 0; period < 2; period++) {
+    EXPECT(!scheduler.skip(2));  // フェードアウト中のソースは外さない
+    EXPECT(scheduler.getCurrent() == &second);
+    EXPECT(scheduler.read(reinterpret_cast<std::uint8_t*>(block), sizeof(block)) == sizeof(block));
+    for (std::size_t i = 0; i < frames; i++) {
+      EXPECT(previous <= block[i]);
+      previous = block[i];
+    }
+  }
+  EXPECT(!scheduler.isCrossfading());
+  EXPECT(scheduler.read(reinterpret_cast<std::uint8_t*>(block), sizeof(block)) == sizeof(block));
+  EXPECT(block[0] == 16000 && block[frames - 1] == 16000);
+
+  EXPECT(scheduler.skip(1));
+  EXPECT(scheduler.getCurrent() == &third);
+}
+
+int main() {
+  DummyAudio output(16000, 16, 10, 1);
+  testGaplessJoins(output);
+  testCrossfade(output);
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
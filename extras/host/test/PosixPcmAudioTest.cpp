@@ -0,0 +1,49 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+// PosixPcmAudio の unpaced 書き込みがパイプ越しにビット単位で読み戻せること、
+// 読み手が閉じたとき (EPIPE) に書けた分だけ playedFrames が進むことを確かめる
+
+#include <PosixPcmAudio.h>
+#include <Arduino.h>
+#include <signal.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define EXPECT(cond) do { if (!(cond)) { fprintf(stderr, "%s:%d: EXPECT(%s)\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+int main() {
+  signal(SIGPIPE, SIG_IGN);
+  int fds[2];
+  EXPECT(pipe(fds) == 0);
+  PosixPcmAudio out(16000, 16, 10, 1, -1, fds[1], false);
+  PosixPcmAudio in(16000, 16, 10, 1, fds[0], -1, false);
+  out.begin();
+  in.begin();
+  out.start();
+  in.start();
+  const std::size_t payload = out.getPayloadSize();
+  std::int16_t written[payload / 2];
+  std::int16_t read[payload / 2];
+  for (int period = 0; period < 4; period++) {
+    for (std::size_t i = 0; i < payload / 2; i++) {
+      written[i] = (std::int16_t)(period * 1000 + i);
+    }
+    EXPECT(out.write(reinterpret_cast<const std::uint8_t*>(written), payload) == payload);
+    EXPECT(in.read(reinterpret_cast<std::uint8_t*>(read), payload) == payload);
+    EXPECT(memcmp(written, read, payload) == 0);
+  }
+  EXPECT(out.getPlayedFrames() == 4 * out.getBufferLength());
+  EXPECT(in.getCapturedFrames() == 4 * in.getBufferLength());
+
+  close(fds[0]);
+  EXPECT(out.write(reinterpret_cast<const std::uint8_t*>(written), payload) == 0);
+  EXPECT(out.getPlayedFrames() == 4 * out.getBufferLength());
+  close(fds[1]);
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+// 大きめの WAV を遅いストレージ越しに WavFileSource で読み、先読みが遅延を隠して全サンプルが
+// ビット単位でそのまま届くこと、遅延の統計 (getHiddenStalls/getMaxFetchMicros/getUnderflows) を確かめる。
+// 遅い読み込みは -Wl,--wrap=fread で fread() を差し替えて注入する。
+
+#include <WavFileSource.h>
+#include <DummyAudio.h>
+#include <Arduino.h>
+#include <atomic>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define EXPECT(cond) do { if (!(cond)) { fprintf(stderr, "%s:%d: EXPECT(%s)\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+extern "C" size_t __real_fread(void* ptr, size_t size, size_t nmemb, FILE* stream);
+
+static std::atomic<std::uint32_t> slowMsec(0);    ///< 0 なら遅延を入れない
+static std::atomic<std::uint32_t> slowEvery(1);   ///< data 読み込み何回ごとに遅延を入れるか
+static std::atomic<std::uint32_t> dataReads(0);
+static std::atomic<std::uint32_t> slowReads(0);
+
+extern "C" size_t __wrap_fread(void* ptr, size_t size, size_t nmemb, FILE* stream) {
+  if (slowMsec && 64 < size * nmemb) {  // ヘッダの細かい読み込みは遅くしない
+    if (dataReads++ % slowEvery == 0) {
+      delay(slowMsec);
+      slowReads++;
+    }
+  }
+  return __real_fread(ptr, size, nmemb, stream);
+}
+
+static std::int16_t pattern(std::uint32_t i) {
+  return (std::int16_t)(i * 2654435761u >> 16);  // 周期の短い値では取り違えを見逃すので散らす
+}
+
+/**
+ * @brief 出力と同じ形式で frames フレーム分の WAV を作る
+ */
+static void writeWav(const char* path, const Audio& audio, std::uint32_t frames) {
+  FILE* file = fopen(path, "wb");
+  EXPECT(file);
+  WavHeader header;
+  header.channels = audio.getChannelNum();
+  header.sampleRate = audio.getSampRate();
+  header.bitsPerSample = audio.getAlignedBitLength();
+  header.dataBytes = frames * header.getBlockAlign();
+  EXPECT(header.write(file));
+  for (std::uint32_t i = 0; i < frames * audio.getChannelNum(); i++) {
+    const std::int16_t v = pattern(i);
+    fwrite(&v, sizeof(v), 1, file);
+  }
+  fclose(file);
+}
+
+/**
+ * @brief 出力周期で read() し、届いたサンプルを元の並びと突き合わせる
+ * @return 読めたサンプル数
+ */
+static std::uint32_t play(WavFileSource& source, const Audio& audio) {
+  const std::size_t payload = audio.getPayloadSize();
+  std::uint8_t block[payload];
+  std::uint32_t samples = 0;
+  bool exact = true;
+  while (!source.finished()) {
+    const std::size_t n = source.read(block, payload);
+    const std::int16_t* s = reinterpret_cast<const std::int16_t*>(block);
+    for (std::size_t i = 0; i < n / sizeof(std::int16_t); i++) {
+      exact = exact && s[i] == pattern(samples++);
+    }
+    delay(audio.getBufferMsec());
+  }
+  EXPECT(exact);
+  return samples;
+}
+
+int main() {
+  DummyAudio audio(16000, 16, 10, 2);
+  const std::uint32_t periods = 250;
+  const std::uint32_t frames = periods * audio.getBufferLength() + audio.getBufferLength() / 2;  // 終端の端数も確かめる
+  char path[] = "/tmp/WavFileSourceTestXXXXXX";
+  const int fd = mkstemp(path);
+  EXPECT(0 <= fd);
+  close(fd);
+  writeWav(path, audio, frames);
+
+  // 周期 (10 ms) より長い 25 ms の読み込みを 16 回に 1 回入れる。8 ブロックの先読みで隠れる
+  {
+    WavFileSource source(audio, 8);
+    slowMsec = 25;
+    slowEvery = 16;
+    dataReads = 0;
+    slowReads = 0;
+    EXPECT(source.open(path));
+    while (source.getReadyBlocks() < 8 && !source.finished()) {
+      delay(1);
+    }
+    EXPECT(play(source, audio) == frames * audio.getChannelNum());
+    EXPECT(dataReads == periods + 1);
+    EXPECT(0 < slowReads && source.getHiddenStalls() == slowReads);
+    EXPECT(25000 <= source.getMaxFetchMicros());
+    EXPECT(source.getUnderflows() == 0);
+    source.close();
+  }
+
+  // 先読み 2 ブロック (20 ms) では 40 ms の読み込みを隠せず、取りこぼしを数えるが中身は崩れない
+  {
+    WavFileSource source(audio, 2);
+    slowMsec = 40;
+    slowEvery = 16;
+    dataReads = 0;
+    slowReads = 0;
+    EXPECT(source.open(path));
+    while (source.getReadyBlocks() < 2 && !source.finished()) {
+      delay(1);
+    }
+    EXPECT(play(source, audio) == frames * audio.getChannelNum());
+    EXPECT(source.getHiddenStalls() == slowReads);
+    EXPECT(40000 <= source.getMaxFetchMicros());
+    EXPECT(0 < source.getUnderflows());
+    source.close();
+  }
+  slowMsec = 0;
+  unlink(path);
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
@@ -6,10 +6,29 @@
 #ifndef LIB_ARDUINO_AUDIO_AUDIO_H_
 #define LIB_ARDUINO_AUDIO_AUDIO_H_
 
+#include "AudioBlock.h"
 #include <cstdint>
+#include <string.h>
+#include <type_traits>
 
 class Audio {
  public:
+  /**
+   * @brief 再生データを生成するコールバック
+   * @param [out] buffer 書き込み先。write() に渡すのと同じ形式の payload 1 本分。
+   * @param [in] frames フレーム数 (getBufferLength())
+   * @param [in] arg 登録時に渡した引数
+   */
+  typedef void (*RenderCallback)(std::uint8_t* buffer, std::size_t frames, void* arg);
+
+  /**
+   * @brief 録音データを受け取るコールバック
+   * @param [in] buffer 録音データ。read() で得られるのと同じ形式の payload 1 本分。
+   * @param [in] frames フレーム数 (getBufferLength())
+   * @param [in] arg 登録時に渡した引数
+   */
+  typedef void (*CaptureCallback)(const std::uint8_t* buffer, std::size_t frames, void* arg);
+
   virtual void begin() = 0;
   virtual void start() = 0;
   virtual void stop() = 0;
@@ -23,6 +42,29 @@ class Audio {
   virtual int availableForWrite() = 0;
   virtual int available() = 0;
 
+  /**
+   * @brief 再生コールバックを登録する。process() の中で空きバッファができるたびに呼ばれる。
+   * @param [in] callback コールバック。nullptr で解除。
+   * @param [in] arg コールバックへ渡す引数。
+   * @return 対応していないとき false
+   */
+  virtual bool setRenderCallback(RenderCallback /*callback*/, void* /*arg*/ = nullptr) { return false; }
+
+  /**
+   * @brief 録音コールバックを登録する。process() の中で録音バッファが埋まるたびに呼ばれる。
+   * @param [in] callback コールバック。nullptr で解除。
+   * @param [in] arg コールバックへ渡す引数。
+   * @return 対応していないとき false
+   */
+  virtual bool setCaptureCallback(CaptureCallback /*callback*/, void* /*arg*/ = nullptr) { return false; }
+
+  /**
+   * @brief バッファの空き/録音完了を待ち、登録済みコールバックを呼ぶ
+   * @param [in] maxWaitMsec 最大待ち時間。
+   * @return コールバックを呼べる状態だったとき true
+   */
+  virtual bool process(std::uint32_t /*maxWaitMsec*/ = UINT32_MAX) { return false; }
+
   /**
    * @brief read from mic
    * @param [in] buffer audio buffer
@@ -39,6 +81,95 @@ class Audio {
    */
   virtual std::size_t write(const std::uint8_t *buffer, std::size_t byteLength) = 0;
 
+  /**
+   * @brief read from mic into a block view
+   * @param [in] block destination. frames must be getBufferLength() and the size must match getPayloadSize().
+   * @return read frames
+   */
+  template<class T>
+  std::size_t readBlock(const AudioBlock<T>& block) {
+    const std::size_t byteLength = block.samples() * sizeof(T);
+    if (block.frames != getBufferLength() || byteLength != getPayloadSize()) {
+      return 0;
+    }
+    if (block.isContiguous()) {
+      return read(reinterpret_cast<std::uint8_t*>(block.data), byteLength) ? block.frames : 0;
+    }
+    T tmp[block.samples()];
+    if (!read(reinterpret_cast<std::uint8_t*>(tmp), byteLength)) {
+      return 0;
+    }
+    for (std::size_t i = 0; i < block.frames; i++) {
+      memcpy(block.frame(i), tmp + i * block.channels, block.channels * sizeof(T));
+    }
+    return block.frames;
+  }
+
+  /**
+   * @brief write a block view to speaker
+   * @param [in] block source. frames must be getBufferLength() and the size must match getPayloadSize().
+   * @return written frames
+   */
+  template<class T>
+  std::size_t writeBlock(const AudioBlock<T>& block) {
+    const std::size_t byteLength = block.samples() * sizeof(T);
+    if (block.frames != getBufferLength() || byteLength != getPayloadSize()) {
+      return 0;
+    }
+    if (block.isContiguous()) {
+      return write(reinterpret_cast<const std::uint8_t*>(block.data), byteLength) ? block.frames : 0;
+    }
+    typename std::remove_const<T>::type tmp[block.samples()];
+    for (std::size_t i = 0; i < block.frames; i++) {
+      memcpy(tmp + i * block.channels, block.frame(i), block.channels * sizeof(T));
+    }
+    return write(reinterpret_cast<const std::uint8_t*>(tmp), byteLength) ? block.frames : 0;
+  }
+
+  /**
+   * @brief make a block view of one payload for this format
+   * @param [in] buffer getPayloadSize() bytes
+   * @return view with getBufferLength() frames
+   */
+  template<class T>
+  AudioBlock<T> makeBlock(T* buffer) const {
+    return AudioBlock<T>(buffer, getBufferLength(), (std::uint8_t)(getPayloadSize() / (getBufferLength() * sizeof(T))));
+  }
+
+  /**
+   * @brief read from mic with the frame index of the first captured frame
+   * @param [in] buffer audio buffer
+   * @param [in] byteLength buffer length (bytes)
+   * @param [out] frameIndex index of the first frame in buffer (frames since start)
+   * @return buffer length (bytes)
+   */
+  virtual std::size_t readTimestamped(std::uint8_t *buffer, std::size_t byteLength, std::uint64_t *frameIndex) {
+    if (frameIndex) {
+      *frameIndex = getCapturedFrames();
+    }
+    return read(buffer, byteLength);
+  }
+
+  /**
+   * @return played frames since start (monotonic)
+   */
+  virtual std::uint64_t getPlayedFrames() const { return 0; }
+
+  /**
+   * @return captured frames since start (monotonic)
+   */
+  virtual std::uint64_t getCapturedFrames() const { return 0; }
+
+  /**
+   * @return estimated output latency (frames) of the next written frame
+   */
+  virtual std::uint32_t getOutputLatencyFrames() const { return 0; }
+
+  /**
+   * @return count of output periods that ran out of written data since start
+   */
+  virtual std::uint32_t getUnderrunCount() const { return 0; }
+
   /**
    * @return sampling rate (Hz)
    */
@@ -0,0 +1,66 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOACTIVITYDETECTOR_H_
+#define LIB_ARDUINO_AUDIO_AUDIOACTIVITYDETECTOR_H_
+
+#include "AudioBlock.h"
+
+/**
+ * @brief 周期ごとのエネルギー (平均絶対値) による有音/無音判定
+ *
+ * 閾値を超えた時点で走査を打ち切るので、有音周期の判定は安い。
+ * 無音と判定しても hangover 周期の間は有音のまま扱い、語尾を切らない。
+ */
+class AudioActivityDetector {
+ public:
+  /**
+   * @param [in] threshold 平均絶対値の閾値 (16bit 換算)。
+   * @param [in] hangoverPeriods 無音になってから有音を保つ周期数。
+   */
+  explicit AudioActivityDetector(std::int32_t threshold = 64, std::uint16_t hangoverPeriods = 8);
+
+  /**
+   * @brief 1 周期分を判定する
+   * @return hangover を含めて有音なら true
+   */
+  bool update(const AudioBlock<const std::int16_t>& block);
+
+  /**
+   * @brief 1 周期分を判定する。32bit は上位 16bit で比較する。
+   */
+  bool update(const AudioBlock<const std::int32_t>& block);
+
+  bool isActive() const;
+
+  void setThreshold(std::int32_t threshold);
+  void setHangover(std::uint16_t periods);
+
+  void reset();
+
+  /**
+   * @return 有音と判定した周期数
+   */
+  std::uint32_t getActivePeriods() const;
+
+  /**
+   * @return 無音と判定した周期数
+   */
+  std::uint32_t getSilentPeriods() const;
+
+ private:
+  template<class T>
+  bool detect(const AudioBlock<const T>& block, int shift) const;
+  bool commit(bool voiced);
+
+  std::int32_t threshold;
+  std::uint16_t hangoverPeriods;
+  std::uint16_t hangover;
+  bool active;
+  std::uint32_t activePeriods;
+  std::uint32_t silentPeriods;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOACTIVITYDETECTOR_H_
@@ -0,0 +1,73 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOANALYZER_H_
+#define LIB_ARDUINO_AUDIO_AUDIOANALYZER_H_
+
+#include "AudioBlock.h"
+#include "AudioFft.h"
+
+/**
+ * @brief 録音 1 周期ごとのレベル (peak/RMS) とスペクトルを求める
+ *
+ * I2SAudio::setCaptureAnalyzer() で登録すると、rxBuffer へ読み込んだ直後に
+ * コピーせずそのまま解析する。
+ */
+class AudioAnalyzer {
+ public:
+  static const std::uint8_t MaxChannels = 2;
+
+  struct Level {
+    std::int32_t peak;  ///< 絶対値の最大
+    float rms;          ///< 二乗平均平方根
+  };
+
+  /**
+   * @param [in] fftSize FFT 点数 (4 以上の 2 の冪)。0 のときはレベルだけ求める。
+   */
+  explicit AudioAnalyzer(std::size_t fftSize = 0);
+  ~AudioAnalyzer();
+
+  /**
+   * @brief 1 周期分を解析する
+   */
+  void analyze(const AudioBlock<const std::int16_t>& block);
+  void analyze(const AudioBlock<const std::int32_t>& block);
+
+  /**
+   * @brief FFT に使うチャンネルを選ぶ
+   */
+  void setFftChannel(std::uint8_t channel);
+
+  /**
+   * @return 直近の周期のレベル
+   */
+  const Level& getLevel(std::uint8_t channel = 0) const;
+
+  /**
+   * @return 直近の周期のパワースペクトル (getSpectrumLength() 点)。FFT 無効時は nullptr。
+   */
+  const float* getSpectrum() const;
+  std::size_t getSpectrumLength() const;
+
+  /**
+   * @return 解析した周期数
+   */
+  std::uint32_t getPeriodCount() const;
+
+ private:
+  template<class T>
+  void analyzeBlock(const AudioBlock<const T>& block);
+
+  AudioFft* const fft;
+  float* const window;    ///< Hann 窓
+  float* const work;      ///< FFT 作業領域 (in-place)
+  float* const spectrum;
+  std::uint8_t fftChannel;
+  Level levels[MaxChannels];
+  std::uint32_t periodCount;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOANALYZER_H_
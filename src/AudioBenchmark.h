@@ -0,0 +1,84 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOBENCHMARK_H_
+#define LIB_ARDUINO_AUDIO_AUDIOBENCHMARK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+class Print;
+
+/**
+ * @brief カーネルの処理時間を計測し、回帰比較しやすい固定書式で出力する
+ *
+ * begin()/end() で 1 回分を計測し、report() で ns/sample, MB/s, パーセンタイルを出す。
+ * ESP32 では CPU サイクルカウンタ、ホスト (extras/host) では CLOCK_MONOTONIC で測る。
+ */
+class AudioBenchmark {
+ public:
+  /**
+   * @param [in] name 出力に使う名前。
+   * @param [in] samplesPerRun 1 回あたりのサンプル数。
+   * @param [in] bytesPerRun 1 回あたりのバイト数。
+   * @param [in] maxRuns 保持する計測回数の上限。
+   */
+  AudioBenchmark(const char* name, std::size_t samplesPerRun, std::size_t bytesPerRun, std::size_t maxRuns = 256);
+  ~AudioBenchmark();
+
+  void reset();
+  void begin();
+  void end();
+
+  /**
+   * @brief runs 回 f() を計測する
+   */
+  template<class F>
+  void run(std::size_t runs, F f) {
+    for (std::size_t i = 0; i < runs; i++) {
+      begin();
+      f();
+      end();
+    }
+  }
+
+  /**
+   * @return 計測済み回数
+   */
+  std::size_t getRuns() const;
+
+  /**
+   * @param [in] percent 0-100
+   * @return パーセンタイル値 (nsec)
+   */
+  std::uint32_t getPercentileNsec(std::uint8_t percent) const;
+
+  /**
+   * @return 1 サンプルあたりの平均処理時間 (nsec)
+   */
+  float getNsecPerSample() const;
+
+  /**
+   * @brief 見出し行を出力する
+   */
+  static void printHeader(Print& out);
+
+  /**
+   * @brief 結果を 1 行で出力する
+   */
+  void report(Print& out) const;
+
+ private:
+  const char* const name;
+  const std::size_t samplesPerRun;
+  const std::size_t bytesPerRun;
+  const std::size_t maxRuns;
+  std::uint32_t* const ticks;  ///< 1 回ごとの計測値 (ESP32 は CPU サイクル、ホストは nsec)
+  std::size_t runs;
+  std::uint64_t totalTicks;
+  std::uint32_t startTicks;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOBENCHMARK_H_
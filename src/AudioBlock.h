@@ -0,0 +1,89 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOBLOCK_H_
+#define LIB_ARDUINO_AUDIO_AUDIOBLOCK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief サンプル型・チャンネル数・フレーム数・ストライドを持つ音声バッファのビュー
+ *
+ * バッファは所有しない。フォーマットはブロック単位で一度だけ確認し、
+ * 処理カーネルは isContiguous() などでブロックごとに選ぶ。
+ * @tparam T サンプル型 (std::int16_t, std::int32_t, float など)
+ */
+template<class T>
+struct AudioBlock {
+  T* data;                 ///< 先頭フレームの先頭チャンネル
+  std::size_t frames;      ///< フレーム数
+  std::uint8_t channels;   ///< 1 フレームのチャンネル数
+  std::size_t stride;      ///< 隣接フレーム間のサンプル数 (>= channels)
+
+  AudioBlock(T* data, std::size_t frames, std::uint8_t channels, std::size_t stride = 0) :
+    data(data), frames(frames), channels(channels), stride(stride ? stride : channels) {
+  }
+
+  /**
+   * @brief AudioBlock<std::int16_t> から AudioBlock<const std::int16_t> などへの変換
+   */
+  template<class U>
+  AudioBlock(const AudioBlock<U>& other) :
+    data(other.data), frames(other.frames), channels(other.channels), stride(other.stride) {
+  }
+
+  T* frame(std::size_t index) const {
+    return data + index * stride;
+  }
+
+  T& at(std::size_t index, std::uint8_t channel) const {
+    return data[index * stride + channel];
+  }
+
+  /**
+   * @return 1 チャンネル分を取り出したビュー
+   */
+  AudioBlock channel(std::uint8_t index) const {
+    return AudioBlock(data + index, frames, 1, stride);
+  }
+
+  /**
+   * @return [begin, begin+count) フレームのビュー
+   */
+  AudioBlock slice(std::size_t begin, std::size_t count) const {
+    return AudioBlock(frame(begin), count, channels, stride);
+  }
+
+  /**
+   * @return 隙間なくインターリーブされているとき true
+   */
+  bool isContiguous() const {
+    return stride == channels;
+  }
+
+  /**
+   * @return 先頭が alignment バイト境界にあるとき true
+   */
+  bool isAligned(std::size_t alignment) const {
+    return (reinterpret_cast<std::uintptr_t>(data) % alignment) == 0;
+  }
+
+  /**
+   * @return 全サンプル数 (frames * channels)
+   */
+  std::size_t samples() const {
+    return frames * channels;
+  }
+
+  /**
+   * @return 連続領域としてのバイト数。isContiguous() のときだけ意味を持つ。
+   */
+  std::size_t byteSize() const {
+    return frames * channels * sizeof(T);
+  }
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOBLOCK_H_
@@ -0,0 +1,50 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOFFT_H_
+#define LIB_ARDUINO_AUDIO_AUDIOFFT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 実数入力の in-place FFT (float, radix-2)
+ *
+ * N 点の実数列を N/2 点の複素 FFT で変換する。回転因子とビット反転表は
+ * コンストラクタで一度だけ作るので、forward() 内で三角関数は呼ばない。
+ */
+class AudioFft {
+ public:
+  /**
+   * @param [in] size FFT 点数。4 以上の 2 の冪。
+   */
+  explicit AudioFft(std::size_t size);
+  ~AudioFft();
+
+  std::size_t getSize() const;
+
+  /**
+   * @brief in-place の順変換
+   *
+   * 出力は packed 形式: data[0] = Re X[0], data[1] = Re X[N/2],
+   * data[2k], data[2k+1] = Re X[k], Im X[k] (1 <= k < N/2)。
+   * @param [in,out] data size 点の実数列。
+   */
+  void forward(float* data) const;
+
+  /**
+   * @brief packed 形式の変換結果からパワースペクトルを求める
+   * @param [in] packed forward() の出力。
+   * @param [out] power size/2+1 点。
+   */
+  void power(const float* packed, float* power) const;
+
+ private:
+  const std::size_t size;
+  float* const twiddle;            ///< e^{-2πik/N} (k < N/2) を re, im の順に並べたもの
+  std::uint16_t* const bitReverse; ///< N/2 点複素 FFT のビット反転表
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOFFT_H_
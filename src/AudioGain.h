@@ -0,0 +1,119 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOGAIN_H_
+#define LIB_ARDUINO_AUDIO_AUDIOGAIN_H_
+
+#include "AudioBlock.h"
+#include <cstdint>
+
+/**
+ * @brief 変換ループに融合して使う固定小数点ゲイン
+ *
+ * ゲインは Q15 (Unity = 1.0)。目標値の変更は指定サンプル数かけてランプさせ、
+ * クリックノイズを出さない。next() はサンプルごとに呼ぶことを想定して inline にしている。
+ */
+class AudioGain {
+ public:
+  static const std::uint16_t Unity = 0x8000;  ///< Q15 の 1.0 (0dB)
+
+  enum RampMode {
+    RampLinear,       ///< 目標値まで一定量ずつ変化させる
+    RampExponential,  ///< 残差の 1/2^n ずつ近づける
+  };
+
+  AudioGain();
+
+  /**
+   * @brief 目標ゲインを設定する
+   * @param [in] gain 目標ゲイン (Q15)。Unity で 0dB、最大で約 +6dB。
+   * @param [in] rampSamples ランプ長 (samples)。0 のときは即時に切り替える。
+   */
+  void setTarget(std::uint16_t gain, std::uint32_t rampSamples = 0);
+
+  /**
+   * @brief ミュートを設定する。解除時は setTarget() 済みのゲインへ戻る。
+   * @param [in] mute true でミュート。
+   * @param [in] rampSamples ランプ長 (samples)。
+   */
+  void setMute(bool mute, std::uint32_t rampSamples = 0);
+
+  void setRampMode(RampMode mode);
+
+  std::uint16_t getTarget() const;
+  bool isMuted() const;
+
+  /**
+   * @return ランプが終わり出力が常に 0 になる状態なら true
+   */
+  bool isSilent() const {
+    return !ramping && current == 0;
+  }
+
+  /**
+   * @return ランプが終わり 0dB で素通しになる状態なら true
+   */
+  bool isUnity() const {
+    return !ramping && current == ((std::int32_t)Unity << FracShift);
+  }
+
+  /**
+   * @brief 1 サンプル分ランプを進める
+   * @return このサンプルに掛けるゲイン (Q15)
+   */
+  inline std::int32_t next() {
+    if (ramping) {
+      if (rampMode == RampLinear) {
+        current += step;
+        if (--remaining == 0) {
+          current = targetValue;
+          ramping = false;
+        }
+      } else {
+        const std::int32_t diff = targetValue - current;
+        const std::int32_t delta = diff >> expShift;
+        current += delta;
+        if ((-(1 << FracShift) < diff && diff < (1 << FracShift)) || delta == 0) {
+          // 残りが 1 段より小さいか、時定数が長くて進まなくなったら目標に揃える
+          current = targetValue;
+          ramping = false;
+        }
+      }
+    }
+    return current >> FracShift;
+  }
+
+  /**
+   * @brief ブロックにその場でゲインを掛ける。ランプは全チャンネル共通。
+   *
+   * 素通し/無音/ランプ中の処理はブロック単位で選ぶ。
+   */
+  void process(const AudioBlock<std::int16_t>& block);
+
+  /**
+   * @brief ゲインを掛けて 16bit に飽和させる
+   */
+  static inline std::int16_t apply(std::int32_t sample, std::int32_t gain) {
+    const std::int32_t v = (sample * gain) >> 15;
+    return (std::int16_t)(v < INT16_MIN ? INT16_MIN : (INT16_MAX < v ? INT16_MAX : v));
+  }
+
+ private:
+  static const int FracShift = 15;  ///< current/step の小数部ビット数 (Q15 << 15 = Q30)
+
+  void updateRamp(std::uint32_t rampSamples);
+
+  RampMode rampMode;
+  std::uint16_t volume;
+  bool muted;
+  bool ramping;
+  std::int32_t current;      ///< 現在のゲイン (Q30)
+  std::int32_t targetValue;  ///< 目標ゲイン (Q30)
+  std::int32_t step;         ///< RampLinear の 1 サンプルあたり変化量 (Q30)
+  std::uint32_t remaining;   ///< RampLinear の残りサンプル数
+  std::uint8_t expShift;     ///< RampExponential の時定数 (2^expShift samples)
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOGAIN_H_
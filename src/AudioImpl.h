@@ -57,15 +57,36 @@ class AudioImpl: public virtual Audio{
   virtual bool waitForWritable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
   virtual bool waitForReadable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
 
+  virtual bool setRenderCallback(RenderCallback callback, void* arg = nullptr) override;
+  virtual bool setCaptureCallback(CaptureCallback callback, void* arg = nullptr) override;
+
+  /**
+   * @brief waitForWritable()/waitForReadable() で待ち、一時バッファ経由でコールバックを呼ぶ
+   */
+  virtual bool process(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+
+ protected:
+  RenderCallback renderCallback;
+  void* renderCallbackArg;
+  CaptureCallback captureCallback;
+  void* captureCallbackArg;
+
+  /**
+   * @brief サンプリング周波数と周期長を変更し、bufferLength/payloadLength を計算し直す
+   * @param [in] sampleRate sampling rate (Hz)
+   * @param [in] bufferMsec buffer length (msec)
+   */
+  void setFormat(std::uint16_t sampleRate, std::uint16_t bufferMsec);
+
  private:
-  const std::uint16_t sampleRate;
+  std::uint16_t sampleRate;
   const std::uint8_t bitDepth;
   const std::uint8_t bitLength;
-  const std::uint16_t bufferMsec;
+  std::uint16_t bufferMsec;
   const std::uint8_t channelNum;
 
-  const std::size_t bufferLength;
-  const std::size_t payloadLength;
+  std::size_t bufferLength;
+  std::size_t payloadLength;
 };
 
 #endif  // LIB_ARDUINO_AUDIO_AUDIOIMPL_H_
@@ -0,0 +1,80 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOPACK24_H_
+#define LIB_ARDUINO_AUDIO_AUDIOPACK24_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 32bit スロットに左詰めした 24bit サンプルと、詰めた 3 バイト表現 (リトルエンディアン) の相互変換
+ *
+ * 両方のポインタが 4 バイト境界にあるときは 4 サンプル (12 バイト) を 32bit 3 ワードで処理する。
+ * 32bit スロットの下位 8bit は pack で捨て、unpack で 0 にする。
+ */
+class AudioPack24 {
+ public:
+  /**
+   * @param [in] src 32bit スロットのサンプル列。
+   * @param [out] dst samples * 3 バイト。
+   * @param [in] samples サンプル数 (フレーム数 * チャンネル数)。
+   */
+  static void pack(const std::int32_t* src, std::uint8_t* dst, std::size_t samples) {
+    std::size_t i = 0;
+    if (((std::uintptr_t)dst & 3) == 0) {
+      std::uint32_t* d = reinterpret_cast<std::uint32_t*>(dst);
+      for (; i + 4 <= samples; i += 4) {
+        const std::uint32_t a = (std::uint32_t)src[i] >> 8;
+        const std::uint32_t b = (std::uint32_t)src[i + 1] >> 8;
+        const std::uint32_t c = (std::uint32_t)src[i + 2] >> 8;
+        const std::uint32_t e = (std::uint32_t)src[i + 3] >> 8;
+        *d++ = a | (b << 24);
+        *d++ = (b >> 8) | (c << 16);
+        *d++ = (c >> 16) | (e << 8);
+      }
+    }
+    for (; i < samples; i++) {
+      const std::uint32_t v = (std::uint32_t)src[i];
+      dst[i * 3] = (std::uint8_t)(v >> 8);
+      dst[i * 3 + 1] = (std::uint8_t)(v >> 16);
+      dst[i * 3 + 2] = (std::uint8_t)(v >> 24);
+    }
+  }
+
+  /**
+   * @param [in] src samples * 3 バイト。
+   * @param [out] dst 32bit スロットのサンプル列。
+   * @param [in] samples サンプル数 (フレーム数 * チャンネル数)。
+   */
+  static void unpack(const std::uint8_t* src, std::int32_t* dst, std::size_t samples) {
+    std::size_t i = 0;
+    if (((std::uintptr_t)src & 3) == 0) {
+      const std::uint32_t* s = reinterpret_cast<const std::uint32_t*>(src);
+      for (; i + 4 <= samples; i += 4) {
+        const std::uint32_t w0 = *s++;
+        const std::uint32_t w1 = *s++;
+        const std::uint32_t w2 = *s++;
+        dst[i] = (std::int32_t)(w0 << 8);
+        dst[i + 1] = (std::int32_t)(((w0 >> 24) << 8) | (w1 << 16));
+        dst[i + 2] = (std::int32_t)(((w1 >> 16) << 8) | (w2 << 24));
+        dst[i + 3] = (std::int32_t)(w2 & 0xFFFFFF00u);
+      }
+    }
+    for (; i < samples; i++) {
+      dst[i] = (std::int32_t)((std::uint32_t)src[i * 3] << 8 | (std::uint32_t)src[i * 3 + 1] << 16 |
+                              (std::uint32_t)src[i * 3 + 2] << 24);
+    }
+  }
+
+  /**
+   * @return 32bit スロットの byteLength を詰めたときのバイト数
+   */
+  static constexpr std::size_t packedSize(std::size_t byteLength) {
+    return byteLength / 4 * 3;
+  }
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOPACK24_H_
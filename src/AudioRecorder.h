@@ -0,0 +1,94 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIORECORDER_H_
+#define LIB_ARDUINO_AUDIO_AUDIORECORDER_H_
+
+#include "Audio.h"
+#include "WavHeader.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+/**
+ * @brief 録音データを WAV ファイルへ非同期に書き出すシンク
+ *
+ * push() は空きブロックへコピーしてキューに積むだけで、ストレージを待たない。
+ * ファイルへの書き込みは別タスクで行う。空きブロックが無いときはその周期を捨てて数える。
+ * ファイルは stdio で開くので、ホスト (extras/host、タスクは std::thread で模擬) では POSIX ファイルへ書く。
+ */
+class AudioRecorder {
+ public:
+  /**
+   * @param [in] blockSize 1 ブロックのバイト数 (録音 payload 長)。
+   * @param [in] blockCount ブロック数。ストレージの最悪書き込み時間 / 周期 より多くする。
+   */
+  AudioRecorder(std::size_t blockSize, std::uint8_t blockCount);
+  ~AudioRecorder();
+
+  /**
+   * @brief ファイルを作成し、書き込みタスクを開始する
+   * @param [in] path 保存先 (fopen() で開けるパス)。
+   * @param [in] audio 録音フォーマットの取得元。
+   * @param [in] priority 書き込みタスクの優先度。
+   * @return 開始できたとき true
+   */
+  bool open(const char* path, const Audio& audio, UBaseType_t priority = 1);
+
+  /**
+   * @brief 1 ブロック分の録音データを積む。ブロッキングしない。
+   * @param [in] data 録音データ。
+   * @param [in] length バイト数。blockSize を超える分は捨てる。
+   * @return 積めたとき true。空きブロックが無く捨てたとき false。
+   */
+  bool push(const std::uint8_t* data, std::size_t length);
+
+  /**
+   * @brief 積んだ分を書き終えるのを待ち、ヘッダを確定してファイルを閉じる
+   */
+  void close();
+
+  /**
+   * @brief Audio::setCaptureCallback() にそのまま渡せるコールバック。arg に AudioRecorder* を渡す。
+   */
+  static void captureCallback(const std::uint8_t* buffer, std::size_t frames, void* arg);
+
+  bool isOpen() const;
+  std::uint32_t getWrittenBlocks() const;
+  std::uint32_t getDroppedBlocks() const;
+  std::uint64_t getWrittenBytes() const;
+
+  /**
+   * @return 1 ブロックの書き込みにかかった最大時間 (usec)
+   */
+  std::uint32_t getMaxWriteMicros() const;
+
+  /**
+   * @return ストレージへの書き込みスループット (bytes/sec)
+   */
+  std::uint32_t getThroughput() const;
+
+ private:
+  static void writerTask(void* arg);
+  void writeLoop();
+
+  const std::size_t blockSize;
+  const std::uint8_t blockCount;
+  std::uint8_t* const pool;
+  std::size_t* const blockLength;
+  QueueHandle_t freeQueue;
+  QueueHandle_t fullQueue;
+  SemaphoreHandle_t writerDone;
+  FILE* file;
+  WavHeader header;
+
+  volatile std::uint32_t writtenBlocks;
+  volatile std::uint32_t droppedBlocks;
+  volatile std::uint64_t writtenBytes;
+  volatile std::uint32_t maxWriteMicros;
+  volatile std::uint64_t totalWriteMicros;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIORECORDER_H_
@@ -0,0 +1,35 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_AUDIOSOURCE_H_
+#define LIB_ARDUINO_AUDIO_AUDIOSOURCE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 再生データの供給元
+ *
+ * read() は出力先 Audio の write() にそのまま渡せる形式で payload を返す。
+ */
+class AudioSource {
+ public:
+  virtual ~AudioSource() {}
+
+  /**
+   * @brief 次の payload を取り出す。ブロッキングしない。
+   * @param [out] buffer 出力先。
+   * @param [in] byteLength 出力先のバイト数 (通常は Audio::getPayloadSize())。
+   * @return 書き込んだバイト数。準備ができていないときや終端では byteLength 未満になる。
+   */
+  virtual std::size_t read(std::uint8_t* buffer, std::size_t byteLength) = 0;
+
+  /**
+   * @return これ以上データが出てこないとき true
+   */
+  virtual bool finished() const = 0;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_AUDIOSOURCE_H_
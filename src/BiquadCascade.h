@@ -0,0 +1,101 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_BIQUADCASCADE_H_
+#define LIB_ARDUINO_AUDIO_BIQUADCASCADE_H_
+
+#include "AudioBlock.h"
+
+/**
+ * @brief 2 次 IIR (biquad) を直列につないだフィルタ (EQ、ローカット、クロスオーバー)
+ *
+ * 係数はサンプリング周波数を決めた時点で float と固定小数点 (Q28) の両方に変換しておく。
+ * 状態は [段][チャンネル] の順に並べ、チャンネル方向の内側ループをベクトル化しやすくしている。
+ * 浮動小数点は転置直接形 II、整数は丸め誤差の少ない直接形 I で処理する。
+ */
+class BiquadCascade {
+ public:
+  static const std::uint8_t MaxSections = 8;
+  static const std::uint8_t MaxChannels = 2;
+  static const int CoeffShift = 28;  ///< 固定小数点係数の小数部ビット数 (±8 まで表せる)
+
+  /**
+   * @brief 正規化済み (a0 = 1) の係数
+   */
+  struct Coefficients {
+    float b0, b1, b2;
+    float a1, a2;
+  };
+
+  /**
+   * @param [in] sampleRate サンプリング周波数 (Hz)。設計関数はこの周波数で係数を求める。
+   */
+  explicit BiquadCascade(std::uint32_t sampleRate);
+
+  /**
+   * @brief 段を追加する
+   * @return 段数が MaxSections を超えるとき false
+   */
+  bool addSection(const Coefficients& c);
+
+  /**
+   * @brief 既存の段の係数を差し替える。状態は保持する。
+   */
+  bool setSection(std::uint8_t index, const Coefficients& c);
+
+  bool addPeaking(float frequency, float q, float gainDb);
+  bool addLowShelf(float frequency, float q, float gainDb);
+  bool addHighShelf(float frequency, float q, float gainDb);
+  bool addHighPass(float frequency, float q = 0.70710678f);
+  bool addLowPass(float frequency, float q = 0.70710678f);
+
+  /**
+   * @brief 段をすべて取り除く
+   */
+  void clear();
+
+  /**
+   * @brief フィルタ状態を 0 に戻す
+   */
+  void reset();
+
+  std::uint8_t getSectionCount() const;
+  std::uint32_t getSampRate() const;
+
+  /**
+   * @brief ブロックをその場でフィルタする。MaxChannels を超えるチャンネルは処理しない。
+   */
+  void process(const AudioBlock<float>& block);
+  void process(const AudioBlock<std::int16_t>& block);  ///< 内部は Q31
+  void process(const AudioBlock<std::int32_t>& block);  ///< Q31
+
+  /**
+   * @brief RBJ Audio EQ Cookbook による設計
+   * @param [in] sampleRate サンプリング周波数 (Hz)。
+   * @param [in] frequency 中心/カットオフ周波数 (Hz)。
+   * @param [in] q Q 値。シェルフではスロープ相当。
+   * @param [in] gainDb ゲイン (dB)。
+   */
+  static Coefficients peaking(std::uint32_t sampleRate, float frequency, float q, float gainDb);
+  static Coefficients lowShelf(std::uint32_t sampleRate, float frequency, float q, float gainDb);
+  static Coefficients highShelf(std::uint32_t sampleRate, float frequency, float q, float gainDb);
+  static Coefficients highPass(std::uint32_t sampleRate, float frequency, float q);
+  static Coefficients lowPass(std::uint32_t sampleRate, float frequency, float q);
+
+ private:
+  template<std::uint8_t Channels>
+  void processFloat(const AudioBlock<float>& block);
+  template<std::uint8_t Channels>
+  void processFixed(const AudioBlock<std::int32_t>& block);
+
+  const std::uint32_t sampleRate;
+  std::uint8_t sectionCount;
+  Coefficients coeffs[MaxSections];
+  std::int32_t fixedCoeffs[MaxSections][5];         ///< b0, b1, b2, a1, a2 (Q28)
+  float floatState[MaxSections][MaxChannels][2];     ///< 転置直接形 II の z1, z2
+  std::int32_t fixedState[MaxSections][MaxChannels][4];  ///< 直接形 I の x1, x2, y1, y2 (Q31)
+};
+
+#endif  // LIB_ARDUINO_AUDIO_BIQUADCASCADE_H_
@@ -20,6 +20,12 @@ class DummyAudio : public AudioImpl {
   int availableForWrite() override;
   std::size_t read(uint8_t *buffer, std::size_t length) override;
   std::size_t write(const uint8_t *buffer, std::size_t length) override;
+  std::uint64_t getPlayedFrames() const override;
+  std::uint64_t getCapturedFrames() const override;
+
+ private:
+  std::uint64_t playedFrames = 0;
+  std::uint64_t capturedFrames = 0;
 };
 
 #endif  // LIB_ARDUINO_AUDIO_DUMMYAUDIO_H_
\ No newline at end of file
@@ -7,6 +7,8 @@
 #define LIB_ARDUINO_AUDIO_ESP32BUILTINDACAUDIO_H_
 
 #include "I2SAudio.h"
+#include "AudioGain.h"
+#include "AudioActivityDetector.h"
 
 class Esp32BuiltinDacAudio : public I2SAudio {
   using super = I2SAudio;
@@ -21,10 +23,17 @@ class Esp32BuiltinDacAudio : public I2SAudio {
     DacStopping, // 0.5->0
     DacStopped,  // 0
   } dacStatus = DacStopped;
+  /**
+   * @brief 開始/停止の遷移が終わったときに呼ばれるコールバック
+   * @param [in] status DacRunning または DacStopped。
+   * @param [in] arg 登録時に渡したポインタ。
+   */
+  typedef void (*DacStatusCallback)(DacStatus status, void* arg);
   const i2s_dac_mode_t dac_mode;
   const std::uint16_t dcCutOffFrequency;
   float dcBlockPrevInput = 0.0f;
   float dcBlockPrevOutput = 0.0f;
+  AudioGain gain;  ///< write() の変換ループ内で掛ける音量
 
   /**
    * @brief ESP32内蔵DAC用I2S出力を初期化する
@@ -63,27 +72,82 @@ class Esp32BuiltinDacAudio : public I2SAudio {
   virtual void begin() override;
 
   /**
-   * @brief 音声出力の開始。以降writeを途切れさせないこと
+   * @brief 音声出力の開始。ブロッキングしない。
+   *
+   * 0V から中立へのランプは DMA のドレインに合わせて少しずつリングへ積む。
+   * ランプを積み終えると DacRunning になり、availableForWrite() が 0 でなくなる。
+   * 停止の途中で呼ぶと、その時点のレベルから折り返す。
    */
   virtual void start() override;
 
   /**
-   * @brief 音声出力の停止。
+   * @brief 音声出力の停止。ブロッキングしない。
+   *
+   * 積み済みのデータの後に中立から 0V へのランプを積み、送出し終えたところで I2S を止めて DacStopped になる。
+   * 遷移は process()/availableForWrite()/write() などで DMA イベントを処理するたびに進む。
    */
   virtual void stop() override;
 
   /**
-   * @brief DAC 状態に応じた無音データを書き込む
+   * @brief リングと DMA を捨てる。再生中なら 0V から中立へランプし直す。
    */
   virtual void zero() override;
 
+  /**
+   * @brief 開始/停止の遷移中は、遷移が終わるまで待ってから空きを待つ
+   */
+  virtual bool waitForWritable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+
+  /**
+   * @brief 開始/停止の遷移が終わるまで DMA イベントを処理しながら待つ
+   * @param [in] maxWaitMsec 最大待ち時間 (msec)。
+   * @return 遷移が終わったとき true
+   */
+  bool waitForTransition(std::uint32_t maxWaitMsec = UINT32_MAX);
+
+  /**
+   * @return 開始/停止のランプ中のとき true
+   */
+  bool isTransitioning() const;
+
+  /**
+   * @brief 開始/停止の完了を知らせるコールバックを登録する。DMA イベントを処理したタスクから呼ばれる。
+   * @param [in] callback コールバック。nullptr で解除。
+   * @param [in] arg コールバックへ渡すポインタ。
+   */
+  void setStatusCallback(DacStatusCallback callback, void* arg = nullptr);
+
   /**
    * @brief 再生中に TX が空になったときの無音 payload を DMA へ直接補充する
    */
   bool handleTxIdle() override;
   
+  /**
+   * @brief 一定レベルの payload を getBufferCount() 本、空きの範囲でリングへ積む。ブロッキングしない。
+   */
   void fill(int16_t v);
 
+  /**
+   * @brief 音量を設定する。write() の変換ループ内でランプしながら掛ける。
+   * @param [in] volume 音量 (Q15)。AudioGain::Unity で 0dB。
+   * @param [in] rampMsec 変化にかける時間 (msec)。
+   * @param [in] mode ランプの形。
+   */
+  void setVolume(std::uint16_t volume, std::uint16_t rampMsec = 10, AudioGain::RampMode mode = AudioGain::RampLinear);
+
+  /**
+   * @brief ミュートを設定する。ランプ完了後は変換を省略し、キャッシュ済みの無音 payload を送る。
+   * @param [in] mute true でミュート。
+   * @param [in] rampMsec 変化にかける時間 (msec)。
+   */
+  void setMute(bool mute, std::uint16_t rampMsec = 10);
+
+  /**
+   * @brief 無音判定を設定する。無音周期は変換を省略し、キャッシュ済みの無音 payload を送る。
+   * @param [in] detector 判定器。nullptr で解除。
+   */
+  void setTxActivityDetector(AudioActivityDetector* detector);
+
   virtual const std::size_t getPayloadSize() const override;
 
   /**
@@ -96,6 +160,8 @@ class Esp32BuiltinDacAudio : public I2SAudio {
 
   /**
    * @brief バッファを書き込み、音声を再生する
+   *
+   * 一時停止中 (setIdleSuspend()) と一時停止前のランプ中は DAC が 0V 側にいるので、1 周期で中立へランプしてから積む。
    * @param [in] buf 再生データを保持するバッファ。
    * @param [in] size 再生データ長。
    * @return 書き込んだデータのバイト数。
@@ -113,6 +179,56 @@ class Esp32BuiltinDacAudio : public I2SAudio {
    * @return 書き込み可能長さ
    */
   int availableForWrite() override;
+
+ protected:
+  /**
+   * @brief I2S 開始直後に DAC 出力を 0 から中立へランプさせる
+   */
+  void onStarted() override;
+
+  /**
+   * @brief reconfigure() 後に DC カットの状態を戻す。DMA を中立で詰め直していればランプしない
+   */
+  void onFormatChanged() override;
+
+  /**
+   * @brief 再生中の reconfigure() では、ゼロクリアされた DMA (0V) を中立の無音で詰め直す
+   */
+  void onTxDmaCleared() override;
+
+  /**
+   * @brief 開始/停止のランプをリングの空きだけ積み、遷移の完了を判定する
+   */
+  void onTxDrain() override;
+
+  /**
+   * @brief 再生中なら中立から 0V へ 1 周期でランプしてから、onTxDrain() で一時停止する
+   * @return 常に false。遷移中は一時停止しない
+   */
+  bool canSuspend() override;
+
+  /**
+   * @brief 再生コールバックにモノラル 16bit で書かせ、write() と同じ変換を通してリングへ積む
+   *
+   * 開始/停止のランプ中 (DacRunning 以外) は呼び出さず、ユーザーの音声をランプに混ぜない。
+   */
+  void renderTxSlot() override;
+
+ private:
+  void buildSilenceTxPayload();
+  void buildLevelTxPayload(std::uint8_t* payload, std::uint8_t rampSlot) const;
+  void rewindTransition();
+  std::uint8_t getStopSlots() const;
+  void setDacStatus(DacStatus status);
+
+  std::uint8_t* silenceTxPayload = nullptr;  ///< 中立レベルを変換済みの TX payload。begin() で reserveFormat() の最大の長さで作る
+  std::size_t silenceTxPayloadSize = 0;
+  AudioActivityDetector* txActivityDetector = nullptr;
+  std::uint8_t rampSlot = 0;  ///< 今の遷移でリングへ積んだ周期数。停止は getStopSlots() 本
+  std::uint8_t rampSlots = 0;  ///< ランプの周期数。開始/停止は getBufferCount()、一時停止の前後は 1
+  bool suspending = false;    ///< 一時停止前の 0V へのランプ中。dacStatus は DacRunning のまま
+  DacStatusCallback statusCallback = nullptr;
+  void* statusCallbackArg = nullptr;
 };
 
 #endif  // LIB_ARDUINO_AUDIO_ESP32BUILTINDACAUDIO_H_
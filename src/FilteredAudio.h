@@ -0,0 +1,51 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_FILTEREDAUDIO_H_
+#define LIB_ARDUINO_AUDIO_FILTEREDAUDIO_H_
+
+#include "AudioImpl.h"
+#include "BiquadCascade.h"
+
+/**
+ * @brief 再生データを BiquadCascade に通してから出力先へ書き込む Audio
+ *
+ * 出力先と同じフォーマットを持ち、write() 以外はそのまま出力先へ委ねる。
+ * フィルタ状態を進めてから書き込みに失敗しないよう、空きが無いときは何もしない。
+ * 出力先を reconfigure() したときは次の write() で新しい周期長に合わせる。
+ * サンプリング周波数が変わったときは係数が合わなくなるので、新しい周波数のフィルタで作り直すまで write() は 0 を返す。
+ */
+class FilteredAudio : public AudioImpl {
+  using super = AudioImpl;
+ public:
+  /**
+   * @param [in] output 出力先。
+   * @param [in] filter フィルタ。サンプリング周波数は出力先と合わせておく。
+   */
+  FilteredAudio(Audio* output, BiquadCascade* filter);
+  void begin() override;
+  void start() override;
+  void stop() override;
+  void zero() override;
+  void flush() override;
+  int available() override;
+  int availableForWrite() override;
+  bool waitForWritable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+  bool waitForReadable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+  std::size_t read(uint8_t *buffer, std::size_t length) override;
+  std::size_t readTimestamped(uint8_t *buffer, std::size_t length, std::uint64_t *frameIndex) override;
+  std::size_t write(const uint8_t *buffer, std::size_t length) override;
+  std::uint8_t getBufferCount() const override;
+  std::uint64_t getPlayedFrames() const override;
+  std::uint64_t getCapturedFrames() const override;
+  std::uint32_t getOutputLatencyFrames() const override;
+  std::uint32_t getUnderrunCount() const override;
+
+ private:
+  Audio* const output;
+  BiquadCascade* const filter;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_FILTEREDAUDIO_H_
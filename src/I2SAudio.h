@@ -7,6 +7,8 @@
 #define LIB_ARDUINO_AUDIO_I2SAUDIO_H_
 
 #include "AudioImpl.h"
+#include "AudioAnalyzer.h"
+#include "AudioActivityDetector.h"
 #include <freertos/FreeRTOS.h>
 #include <driver/i2s.h>
 
@@ -23,6 +25,11 @@ class I2SAudio: public AudioImpl{
     i2s_comm_format_t comFormat; 
     bool txDescAutoClear;
     i2s_pin_config_t pinConfig;
+    /**
+     * 24bit (alignedBitLength 32) のとき、TX リングと RX バッファに詰めた 3 バイト/サンプルで保持する。
+     * read()/write()/コールバックの形式は 32bit のまま。DMA 転送時だけ 32bit スロットへ展開/圧縮する。
+     */
+    bool packed24Storage;
   };
   /**
    * @brief I2S 音声入出力を初期化する
@@ -71,18 +78,177 @@ class I2SAudio: public AudioImpl{
   virtual bool waitForWritable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
   virtual bool waitForReadable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
 
+  /**
+   * @brief リングに空きがあればすぐに、なければ DMA イベントを待ってコールバックを呼ぶ
+   *
+   * 再生コールバックにはリングのスロットを直接渡すので、コピーは発生しない。
+   */
+  virtual bool process(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+
+  /**
+   * @brief 録音データと、その先頭フレームの通し番号を受け取る
+   */
+  virtual std::size_t readTimestamped(std::uint8_t* buf, std::size_t size, std::uint64_t* frameIndex) override;
+
+  /**
+   * @return I2S_EVENT_TX_DONE で数えた送出済みフレーム数
+   */
+  virtual std::uint64_t getPlayedFrames() const override;
+
+  /**
+   * @return I2S_EVENT_RX_DONE で数えた録音済みフレーム数
+   */
+  virtual std::uint64_t getCapturedFrames() const override;
+
+  /**
+   * @return リングに積まれたフレームと DMA に書き込み済みで未送出のフレームの合計
+   */
+  virtual std::uint32_t getOutputLatencyFrames() const override;
+
+  /**
+   * @return start() 以降、送出データが間に合わず DMA が空のまま送出した周期数
+   */
+  virtual std::uint32_t getUnderrunCount() const override;
+
+  /**
+   * @return 直近に受け取った録音データ (rxBuffer) の先頭フレームの通し番号
+   */
+  std::uint64_t getLastCaptureFrameIndex() const;
+
+  /**
+   * @brief 録音周期ごとに rxBuffer をその場で解析する
+   * @param [in] analyzer 解析器。nullptr で解除。
+   */
+  void setCaptureAnalyzer(AudioAnalyzer* analyzer);
+
+  /**
+   * @brief 録音周期ごとに有音/無音を判定する
+   * @param [in] detector 判定器。nullptr で解除。
+   */
+  void setCaptureActivityDetector(AudioActivityDetector* detector);
+
+  /**
+   * @return 直近の録音周期が無音と判定されたとき true。呼び出し側はその周期の処理を省略できる。
+   */
+  bool isCaptureSilent() const;
+
+  /**
+   * @return TX リング/RX バッファを詰めた 24bit で保持しているとき true
+   */
+  bool isPacked24Storage() const;
+
+  /**
+   * @brief reconfigure() で使う最大のフォーマットを予約する。begin() より前に呼ぶ。
+   *
+   * リングと RX バッファは予約した最大の payload で確保し、reconfigure() では確保し直さない。
+   * @param [in] maxSampleRate 最大のサンプリング周波数。
+   * @param [in] maxBufferMsec 最大の周期長。
+   */
+  void reserveFormat(std::uint16_t maxSampleRate, std::uint16_t maxBufferMsec);
+
+  /**
+   * @brief ドライバを入れ直さずにサンプリング周波数と周期長を変更する
+   *
+   * i2s_set_clk() でクロックだけを変え、リングは確保済みの領域を使い回す。
+   * リングと DMA に積まれていたデータは旧フォーマットなので捨てる。フレームの通し番号は 0 に戻る。
+   * DMA バッファのフレーム数は begin() 時のまま変わらない。
+   * 止まっている/一時停止しているときはクロックを設定せず、次の start()/再開で新しいクロックにする。
+   * 出力先の形式を取り込むクラスのうち、PlaybackScheduler と FilteredAudio (周期長のみ) は次の read()/write() で追従する。
+   * JitterBuffer、WavFileSource、FilteredAudio のフィルタ係数 (サンプリング周波数) は追従しないので作り直すこと。
+   * JitterBuffer の read() と FilteredAudio の write() は、作り直すまで 0 を返す。
+   * @param [in] sampleRate サンプリング周波数。
+   * @param [in] bufferMsec 周期長。
+   * @return 予約した領域に収まらない、または begin() 前のとき false
+   */
+  virtual bool reconfigure(std::uint16_t sampleRate, std::uint16_t bufferMsec);
+
+  /**
+   * @brief TX リングが空のまま指定周期続いたら I2S を一時停止する (TX のみのとき)
+   *
+   * 一時停止中は i2s_stop() でクロックと DMA 割り込みを止め、DMA をゼロクリアしておく。
+   * 次の write() ではピン/クロック/ドライバの設定を省き、i2s_start() だけで再開する。
+   * 周期は DMA イベントを処理したときに数えるので、process()/availableForWrite() などを呼び続けること。
+   * 再生コールバックは毎周期リングを埋めるので、コールバック駆動では一時停止しない。
+   * @param [in] idlePeriods リングと DMA の書き込み済みデータを送出し終えてからの周期数。0 で無効。
+   */
+  void setIdleSuspend(std::uint16_t idlePeriods);
+
+  /**
+   * @return 無音が続いて I2S を一時停止しているとき true
+   */
+  bool isSuspended() const;
+
+  std::uint32_t getSuspendCount() const;
+  std::uint32_t getLastResumeMicros() const;  ///< 直近の再開 (resume() から、再開後に書いたデータの最初の送出完了まで) にかかった時間
+  std::uint32_t getMaxResumeMicros() const;
+
  protected:
   enum I2SAudioStatus {
     I2SAudioStop,
     I2SAudioOscillation,
-    I2SAudioStart
+    I2SAudioStart,
+    I2SAudioSuspend  ///< setIdleSuspend() による一時停止。ピンとクロックの設定は残っている
   };
   void _start(I2SAudioStatus s);
+
+  /**
+   * @brief i2s_start() 直前までの開始準備 (ピン、クロック、DMA ゼロクリア)
+   */
+  void _prepareStart();
+
+  /**
+   * @brief i2s_start() 直後の状態初期化
+   */
+  void _finishStart(I2SAudioStatus s);
+
+  /**
+   * @brief start() 完了後に呼ばれる。開始直後に流すデータはここで書き込む。
+   */
+  virtual void onStarted();
+
+  /**
+   * @brief reconfigure() でフォーマットが変わった直後に呼ばれる。フォーマットに依存するキャッシュはここで作り直す。
+   */
+  virtual void onFormatChanged();
+
+  /**
+   * @brief reconfigure() で DMA をゼロクリアした後、ポートを再開する直前に呼ばれる
+   *
+   * DMA の 0 が無音にならない出力 (内蔵 DAC の 0V など) は、ここで writeTxDmaBuffer() で無音を詰め直す。
+   */
+  virtual void onTxDmaCleared();
+
+  /**
+   * @brief TX リングから DMA へドレインする直前に呼ばれる
+   *
+   * 開始/停止のランプのように、write() を通さずにリングへ積むデータはここで pushTxSlot() で補充する。
+   */
+  virtual void onTxDrain();
+
   /**
    * @brief TX リングが空になった直後に DMA へ low-level な無音データを書き込む
    */
   virtual bool handleTxIdle();
 
+  /**
+   * @brief 無音が続いて一時停止する直前に呼ばれる
+   *
+   * false を返した派生クラスは、準備 (0V へのランプなど) を終えたところで自分で suspend() を呼んでよい。
+   * @return false のときは一時停止しない (遷移中など)
+   */
+  virtual bool canSuspend();
+
+  /**
+   * @brief i2s_stop() で止めて DMA をゼロクリアし、一時停止の状態にする
+   */
+  void suspend();
+
+  /**
+   * @brief 一時停止から i2s_start() だけで再開する。write() から自動で呼ばれる。
+   * @return 一時停止していたとき true
+   */
+  bool resume();
+
   /**
    * @brief DMA バッファを low-level にゼロクリアする
    */
@@ -96,34 +262,120 @@ class I2SAudio: public AudioImpl{
    * @return すべて書き込めたとき true。
    */
   bool writeTxDmaBuffer(const std::uint8_t* payload, std::size_t length, std::uint8_t repeatCount = 1);
+
+  /**
+   * @brief 再生コールバックで TX リングの空きスロットを 1 本埋める
+   *
+   * デフォルトはリングのスロットへ直接書かせる。write() でデータを変換する派生クラスは override する。
+   */
+  virtual void renderTxSlot();
+
+  /**
+   * @brief 書き込み済みの TX リングスロットを確定する
+   */
+  void commitTxSlot();
+
+  /**
+   * @brief 完成済み payload をリングへ 1 本積み、プリフィルを待たずにドレインを始める
+   *
+   * DMA イベントは処理しないので、onTxDrain() の中からも呼べる。
+   * @param [in] payload getPayloadSize() バイトの TX payload。
+   * @return リングが満杯のとき false
+   */
+  bool pushTxSlot(const std::uint8_t* payload);
+
+  /**
+   * @brief begin() でヒープ確保せず、派生クラスが用意した領域をリング/RX バッファに使う
+   * @param [in] ring getRingBufferCount() * getStorageSize() バイト以上の領域。
+   * @param [in] rx getStorageSize() バイト以上の領域。
+   * @param [in] scratch packed24Storage のとき getPayloadSize() / 4 要素以上の展開領域。それ以外は nullptr。
+   */
+  void useStaticBuffers(char* ring, char* rx, std::int32_t* scratch = nullptr);
+
+  /**
+   * @return リング 1 スロット/RX バッファのバイト数。packed24Storage のときは getPayloadSize() の 3/4。
+   */
+  std::size_t getStorageSize() const;
+
+  /**
+   * @return 確保済みのリング 1 スロット/RX バッファのバイト数。reserveFormat() した最大の getStorageSize()
+   */
+  std::size_t getReservedStorageSize() const;
   
  private:
   
+  enum : std::size_t {
+    Pack24ChunkSamples = 64,  ///< packed24 で DMA と受け渡すとき、一度にスタックへ展開するサンプル数
+  };
+
+  void allocateBuffers();
+  std::size_t _writeDma(const char* data, std::size_t length);
+  std::size_t _readDma(char* data, std::size_t length, TickType_t ticks_to_wait);
+  std::size_t _writePacked24Dma(const char* slot, std::size_t offset, std::size_t length);
+  std::size_t _readPacked24Dma(std::size_t offset, std::size_t length, TickType_t ticks_to_wait);
+  void _setClock();
+  void storeTxSlot(const std::uint8_t* payload);
+  std::uint16_t getDmaMsec() const;
   bool _eventQueue(TickType_t);
   bool _recvQueue(i2s_event_type_t type);
+  void _dispatchCallbacks();
+  void analyzeCapture(const char* data);
   std::uint8_t getRingBufferCount() const;
 
   const I2SAudioConfig audioConfig;
-  const i2s_config_t i2sConfig;
+  i2s_config_t i2sConfig;   ///< sample_rate は reconfigure() で変わる
   const std::uint8_t ringBufferCount;
+  const bool packed24;   ///< packed24Storage が有効で、フォーマットが 24bit/32bit のとき true
 
 
   volatile I2SAudioStatus status;
+  std::uint32_t clockSampleRate;  ///< 最後に i2s_set_clk() した設定。同じなら設定し直さない。0 は未設定
+  std::uint32_t clockBitsCfg;
+  i2s_channel_t clockChannel;
+  bool pinConfigured;  ///< i2s_set_pin() 済み。stop() で RTC GPIO に戻すピンが無ければ設定し直さない
 
   // TX リングバッファ: DMA への直接書き込みを廃止し、ソフトウェアバッファ経由でドレイン
-  char *ringTxBuffer;    ///< getRingBufferCount() スロット分のヒープ領域
+  char *ringTxBuffer;    ///< getRingBufferCount() スロット分の領域
+  std::size_t slotSize;  ///< リング 1 スロット/RX バッファの確保済みバイト数 (reserveFormat() の最大)
+  std::size_t ringTxReadOffset;  ///< DMA へ書き終えた、先頭スロット内のバイト数
+  bool staticBuffers;    ///< true のときリング/RX バッファは派生クラスの所有
   int ringTxReadIdx;
   int ringTxWriteIdx;
   int ringTxCount;       ///< 現在リングにあるバッファ数
   bool txPrimed;         ///< true の間だけリングから DMA へドレインする
   bool handlingTxIdle;
   bool txIdleFilled;
+  std::uint16_t idleSuspendPeriods;  ///< 0 のとき一時停止しない
+  std::uint32_t txIdlePeriods;       ///< リングも DMA の書き込み済みデータも空のまま送出した周期数
+  std::uint32_t suspendCount;
+  std::uint32_t lastResumeMicros;
+  std::uint32_t resumeStartMicros;   ///< resume() を呼んだ時刻
+  bool resumePending;                ///< 再開後のデータがまだ送出し終わっていない
+  std::uint32_t maxResumeMicros;
+
+  volatile std::uint64_t playedFrames;    ///< TX_DONE ごとに DMA バッファ 1 本分加算
+  volatile std::uint64_t capturedFrames;  ///< RX_DONE ごとに DMA バッファ 1 本分加算
+  volatile std::uint32_t dmaPendingFrames;  ///< DMA へ書き込み済みで未送出のフレーム数
+  std::uint32_t txUnderruns;
+  bool txDataStarted;                     ///< start() 以降に DMA へデータを書いたとき true
+  std::uint32_t rxPendingFrames;          ///< RX_DONE で届いて、まだ DMA から読み出していないフレーム数
+  std::uint64_t rxFrameIndex;             ///< rxBuffer の先頭フレームの通し番号
 
   std::size_t rxFilled;
+  std::size_t rxReadOffset;  ///< rxBuffer へ読み終えた、周期内のバイト数
   bool rxDone;
   char *rxBuffer;
+  std::int32_t* pack24Scratch;  ///< packed24 のとき、解析とコールバックへ渡す 1 周期分の展開領域
+  AudioAnalyzer* captureAnalyzer;
+  AudioActivityDetector* captureActivityDetector;
+  bool captureSilent;
+
+  bool dispatchingCallbacks;     ///< コールバック中の write() から再入しないためのフラグ
+  std::uint32_t lastEventMsec;  ///< 最後に DMA イベントを処理した時刻。イベントタイムアウト判定用
 
   xQueueHandle i2s_event_queue;
+
+  friend class I2SAudioGroup;
 };
 
 #endif  // LIB_ARDUINO_AUDIO_I2SAUDIO_H_
@@ -0,0 +1,59 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_I2SAUDIOGROUP_H_
+#define LIB_ARDUINO_AUDIO_I2SAUDIOGROUP_H_
+
+#include "I2SAudio.h"
+
+/**
+ * @brief 複数の I2SAudio をまとめて扱う
+ *
+ * 全ポートの i2s_start() を同じ DMA 周期内に揃えて発行し、
+ * 各ポートのイベントキューを pump() 1 か所から処理する。
+ * タイムアウト判定などの状態は各 I2SAudio が個別に持つ。
+ */
+class I2SAudioGroup {
+ public:
+  I2SAudioGroup();
+
+  /**
+   * @brief ポートを追加する。最初に追加したポートの DMA イベントを pump() の待ち合わせに使う。
+   * @param [in] audio 追加する I2SAudio。begin() 前でもよい。
+   * @return 追加できたとき true
+   */
+  bool add(I2SAudio* audio);
+
+  /**
+   * @brief 全ポートの begin() を呼ぶ
+   */
+  void begin();
+
+  /**
+   * @brief 全ポートを同じ DMA 周期で開始する
+   */
+  void start();
+
+  /**
+   * @brief 全ポートを停止する
+   */
+  void stop();
+
+  /**
+   * @brief 全ポートのイベントキューを処理する
+   * @param [in] maxWaitMsec どのポートにもイベントがないときに待つ最大時間。
+   * @return いずれかのポートでイベントを処理したとき true
+   */
+  bool pump(std::uint32_t maxWaitMsec = 0);
+
+  std::uint8_t getCount() const;
+  I2SAudio* get(std::uint8_t index) const;
+
+ private:
+  I2SAudio* ports[I2S_NUM_MAX];
+  std::uint8_t count;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_I2SAUDIOGROUP_H_
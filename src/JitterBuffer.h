@@ -0,0 +1,126 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_JITTERBUFFER_H_
+#define LIB_ARDUINO_AUDIO_JITTERBUFFER_H_
+
+#include "Audio.h"
+#include "AudioSource.h"
+
+/**
+ * @brief パケット化されたストリームの到着揺らぎを吸収するソース
+ *
+ * 1 パケットは出力先の payload 1 周期分で、シーケンス番号の順に並べ替えて再生する。
+ * 到着時刻とタイムスタンプから RFC 3550 の式で到着揺らぎを推定し、再生開始までに溜める周期数を決める。
+ * 間に合わなかった周期は直前の周期を繰り返しながらフェードアウトして補い、read() は毎周期 payload を 1 つ返す。
+ * push() と read() は同じタスクから呼ぶこと。
+ * 出力先を reconfigure() したときは作り直すこと。溜めたパケットと揺らぎの推定は旧フォーマットのものなので、
+ * フォーマットが変わった後の push() は false、read() は 0 を返す。
+ */
+class JitterBuffer : public AudioSource {
+ public:
+  static const std::uint8_t FadePeriods = 4;       ///< 補間でフェードアウトしきるまでの周期数
+  static const std::uint8_t JitterMultiplier = 3;  ///< 推定揺らぎの何倍を遅延として確保するか
+  static const std::uint8_t TrimSlack = 2;         ///< 目標より何周期多く溜まったら間引くか
+
+  /**
+   * @param [in] output 出力先。payload 長とフォーマットをここから決める。フェードは 16bit/32bit のみ。破棄するまで参照する。
+   * @param [in] slotCount 保持できるパケット数。並べ替えの窓と最大遅延を兼ねる。
+   *   シーケンス番号の一巡 (65536) を割り切れるよう、2 の累乗 (2〜64) に切り上げる。
+   * @param [in] minDepth 再生開始までに溜める最小の周期数。
+   */
+  JitterBuffer(const Audio& output, std::uint8_t slotCount = 16, std::uint8_t minDepth = 1);
+  ~JitterBuffer();
+
+  /**
+   * @brief パケットを受け取る
+   * @param [in] sequence シーケンス番号。1 周期ごとに 1 ずつ増える。
+   * @param [in] timestamp 先頭フレームのタイムスタンプ (サンプル単位)。
+   * @param [in] payload 出力先と同じ形式の 1 周期分のデータ。
+   * @param [in] length payload のバイト数。payload 長と一致しないときは捨てる。
+   * @param [in] arrivalMicros 到着時刻 (usec)。ホストで試験するときは模擬時刻を渡す。
+   * @return 格納したとき true。遅着、重複、窓の外、出力先のフォーマットが変わった後は false
+   */
+  bool push(std::uint16_t sequence, std::uint32_t timestamp, const std::uint8_t* payload, std::size_t length, std::uint32_t arrivalMicros);
+#ifdef ARDUINO
+  bool push(std::uint16_t sequence, std::uint32_t timestamp, const std::uint8_t* payload, std::size_t length);  ///< 到着時刻は micros()
+#endif
+
+  /**
+   * @brief ストリームの終わりを知らせる。溜まっている分を出し切ると finished() が true になる。
+   */
+  void setEndOfStream();
+
+  /**
+   * @brief 溜まっているパケットと統計を捨て、最初のパケットを待つ状態へ戻す
+   */
+  void reset();
+
+  /**
+   * @return 常に byteLength。再生前と補間後の無音も含む。byteLength が payload 長と違うときと、出力先のフォーマットが変わった後は 0
+   */
+  std::size_t read(std::uint8_t* buffer, std::size_t byteLength) override;
+  bool finished() const override;
+
+  bool isPlaying() const;
+  std::uint8_t getDepth() const;        ///< 次に再生する周期から最新の受信までの周期数
+  std::uint8_t getTargetDepth() const;  ///< 推定揺らぎから決めた遅延 (周期数)
+  std::uint32_t getJitterMicros() const;
+
+  std::uint32_t getReceived() const;
+  std::uint32_t getConcealed() const;   ///< 補間した周期数
+  std::uint32_t getLate() const;        ///< 再生済み (溜め直す前を含む) の周期に届いて捨てたパケット数
+  std::uint32_t getDuplicates() const;
+  std::uint32_t getOverflows() const;   ///< 窓より先に届いて捨てたパケット数
+  std::uint32_t getTrimmed() const;     ///< 遅延を詰めるために間引いた周期数
+  std::uint32_t getRebuffers() const;   ///< 補間しきれず溜め直した回数
+
+ private:
+  bool formatChanged() const;
+  void updateJitter(std::uint32_t timestamp, std::uint32_t arrivalMicros);
+  void updateTargetDepth();
+  void conceal(std::uint8_t* buffer);
+  std::uint8_t slotIndex(std::uint16_t sequence) const;
+  template<class T>
+  void ramp(T* data, std::int32_t from, std::int32_t to);
+
+  const Audio& output;
+  const std::size_t payloadSize;
+  const std::size_t frames;
+  const std::uint8_t sampleBytes;
+  const std::uint8_t channels;
+  const std::uint32_t sampleRate;
+  const std::uint32_t periodMicros;
+  const std::uint8_t slotCount;  ///< 2 の累乗
+  const std::uint8_t minDepth;
+  std::uint8_t* pool;
+  std::uint16_t* slotSequence;
+  bool* slotValid;
+  std::uint8_t* lastPayload;     ///< 最後に再生した周期。補間の元
+  std::uint8_t bufferedCount;
+  std::uint16_t nextSequence;    ///< 次に再生する周期
+  std::uint16_t highestSequence;
+  std::uint16_t playedSequence;  ///< 再生 (補間、間引きを含む) を済ませた次の周期。溜め直しでは戻さない
+  std::uint8_t targetDepth;
+  bool playing;
+  bool hasPlayed;                ///< reset() 後に再生を始めたことがある
+  bool endOfStream;
+  bool hasLast;
+  bool hasArrival;
+  std::uint32_t lastTimestamp;
+  std::uint32_t lastArrivalMicros;
+  std::uint32_t jitterQ4;        ///< 推定揺らぎ (usec) の 16 倍
+  std::uint8_t concealRun;       ///< 連続して補間した周期数
+  std::int32_t outputGain;       ///< 直前の周期の終わりのゲイン (Q15)
+  std::uint32_t received;
+  std::uint32_t concealed;
+  std::uint32_t late;
+  std::uint32_t duplicates;
+  std::uint32_t overflows;
+  std::uint32_t trimmed;
+  std::uint32_t rebuffers;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_JITTERBUFFER_H_
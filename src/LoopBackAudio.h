@@ -21,10 +21,16 @@ class LoopBackAudio : public AudioImpl {
   int availableForWrite() override;
   std::size_t read(uint8_t *buffer, std::size_t length) override;
   std::size_t write(const uint8_t *buffer, std::size_t length) override;
+  std::uint64_t getPlayedFrames() const override;
+  std::uint64_t getCapturedFrames() const override;
+  std::uint32_t getUnderrunCount() const override;
 
  private:
   std::uint8_t* const echoBuffer;
   std::uint32_t writeTargetMsec;
   bool readable;
+  std::uint64_t playedFrames = 0;
+  std::uint64_t capturedFrames = 0;
+  std::uint32_t underruns = 0;
 };
 #endif  // LIB_ARDUINO_AUDIO_LOOPBACKAUDIO_H_
@@ -0,0 +1,84 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_PLAYBACKSCHEDULER_H_
+#define LIB_ARDUINO_AUDIO_PLAYBACKSCHEDULER_H_
+
+#include "Audio.h"
+#include "AudioSource.h"
+
+/**
+ * @brief 再生ソースのキューを順に途切れなく再生するソース
+ *
+ * 現在のソースが payload の途中で終わったときは、同じ payload の続きのフレームから次のソースを読む。
+ * skip() では次のソースへ切り替え、指定した周期数だけ Q15 のゲインで新旧をクロスフェードする。
+ * 出力先の zero() を呼ばないので、リングに積んだデータは捨てない。
+ * 出力先を reconfigure() したときは、次の read() から新しい payload 長で読む。
+ */
+class PlaybackScheduler : public AudioSource {
+ public:
+  static const std::uint8_t MaxQueue = 8;
+
+  /**
+   * @param [in] output 出力先。payload 長とフォーマットをここから決める (16bit または 32bit)。破棄するまで参照する。
+   */
+  explicit PlaybackScheduler(const Audio& output);
+
+  /**
+   * @brief ソースを末尾に積む。所有権は移らない。
+   * @return キューが満杯のとき false
+   */
+  bool enqueue(AudioSource* source);
+
+  /**
+   * @brief 次のソースへ切り替える
+   * クロスフェード中 (isCrossfading()) は切り替えない。終わってから呼び直す。
+   * @param [in] crossfadePeriods クロスフェードする周期数。0 なら次の read() から即座に切り替える。
+   * @return 切り替えたとき true。キューが空のときとクロスフェード中は false
+   */
+  bool skip(std::uint8_t crossfadePeriods = 0);
+
+  /**
+   * @brief キューと再生中のソースをすべて外す
+   */
+  void clear();
+
+  std::size_t read(std::uint8_t* buffer, std::size_t byteLength) override;
+  bool finished() const override;
+
+  /**
+   * @return 再生中のソース。無いとき nullptr
+   */
+  AudioSource* getCurrent() const;
+  std::uint8_t getQueuedCount() const;
+  bool isCrossfading() const;
+
+  /**
+   * @return 再生中のソースのデータが間に合わず、無音で埋めた回数
+   */
+  std::uint32_t getUnderflows() const;
+
+ private:
+  bool advance();
+  std::size_t readSource(AudioSource* source, std::uint8_t* buffer, std::size_t byteLength, bool isCurrent);
+  template<class T>
+  void mix(T* in, const T* out, std::size_t n);
+
+  const Audio& output;
+  std::size_t payloadSize;      ///< 出力先の reconfigure() で変わる
+  std::size_t frames;
+  const std::uint8_t sampleBytes;
+  const std::uint8_t channels;
+  AudioSource* queue[MaxQueue];
+  std::uint8_t queueHead;
+  std::uint8_t queueCount;
+  AudioSource* current;
+  AudioSource* fading;          ///< フェードアウト中のソース
+  std::uint32_t fadeFrames;     ///< クロスフェード全体のフレーム数
+  std::uint32_t fadePosition;   ///< クロスフェード開始からのフレーム数
+  std::uint32_t underflows;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_PLAYBACKSCHEDULER_H_
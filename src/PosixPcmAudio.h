@@ -0,0 +1,73 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_POSIXPCMAUDIO_H_
+#define LIB_ARDUINO_AUDIO_POSIXPCMAUDIO_H_
+
+#include "AudioImpl.h"
+#include <time.h>
+
+/**
+ * @brief ファイルディスクリプタ上の raw PCM (リトルエンディアン、インターリーブ) で入出力する Audio
+ *
+ * ファイル、パイプ、stdin/stdout をそのまま使えるので、アプリケーションのパイプラインを
+ * Linux 上で動かし、perf でのプロファイルや出力のビット単位の比較ができる。
+ * fd の open/close は呼び出し側で行う。
+ * paced のときは実時間のサンプリング周波数で書き込み/読み込みを許可し、
+ * そうでなければ待たずに全速で動く。
+ * ホストでは extras/host のターゲットでビルドする (基底の AudioImpl が Arduino.h を使うため shim を通す)。
+ */
+class PosixPcmAudio : public AudioImpl {
+  using super = AudioImpl;
+ public:
+  /**
+   * @param [in] inFd 録音データの読み込み元。-1 なら無音を返す。
+   * @param [in] outFd 再生データの書き込み先。-1 なら捨てる。
+   * @param [in] paced 実時間でペーシングするとき true
+   */
+  PosixPcmAudio(std::uint16_t sampleRate, std::uint8_t bitDepth, std::uint16_t bufferMsec, std::uint8_t channelNum,
+                int inFd, int outFd, bool paced = true);
+  void begin() override;
+  void start() override;
+  void stop() override;
+  void zero() override;
+  int available() override;
+  int availableForWrite() override;
+  bool waitForWritable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+  bool waitForReadable(std::uint32_t maxWaitMsec = UINT32_MAX) override;
+  std::size_t read(uint8_t *buffer, std::size_t length) override;
+  std::size_t write(const uint8_t *buffer, std::size_t length) override;
+  std::uint64_t getPlayedFrames() const override;
+  std::uint64_t getCapturedFrames() const override;
+  std::uint32_t getOutputLatencyFrames() const override;
+  std::uint32_t getUnderrunCount() const override;
+
+  /**
+   * @return 入力が終端に達したとき true
+   */
+  bool isInputEnd() const;
+
+ private:
+  /**
+   * @return start() からの経過時間 (frames)
+   */
+  std::uint64_t elapsedFrames() const;
+
+  /**
+   * @brief 経過時間が frames に達するまで、最大 maxWaitMsec 眠る
+   */
+  void sleepUntil(std::uint64_t frames, std::uint32_t maxWaitMsec) const;
+
+  const int inFd;
+  const int outFd;
+  const bool paced;
+  struct timespec epoch;
+  bool inputEnd = false;
+  std::uint64_t playedFrames = 0;
+  std::uint64_t capturedFrames = 0;
+  std::uint32_t underruns = 0;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_POSIXPCMAUDIO_H_
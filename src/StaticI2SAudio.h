@@ -0,0 +1,95 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_STATICI2SAUDIO_H_
+#define LIB_ARDUINO_AUDIO_STATICI2SAUDIO_H_
+
+#include "I2SAudio.h"
+#include "AudioPack24.h"
+
+/**
+ * @brief フォーマットをコンパイル時に固定した I2SAudio
+ *
+ * TX リングと RX バッファをオブジェクト内の静的領域に持ち、begin() でヒープ確保しない。
+ * グローバルに置けばメモリ使用量はリンク時に確定する。
+ * bufferLength() などは constexpr なので、ループ境界を定数にできる。
+ *
+ * @tparam SampleRate サンプリング周波数。
+ * @tparam BitDepth 実ビット深度。
+ * @tparam AlignedBitLength アライン後のビット長。
+ * @tparam BufferMsec DMA 1 本あたりの時間長。
+ * @tparam ChannelNum チャンネル数。
+ * @tparam BufferCount DMA バッファ本数。
+ * @tparam RingBufferCount ソフトウェア TX リング本数。
+ * @tparam Packed24Storage リング/RX バッファを詰めた 24bit で持つ。config.packed24Storage より優先する。
+ */
+template<std::uint16_t SampleRate, std::uint8_t BitDepth, std::uint8_t AlignedBitLength, std::uint16_t BufferMsec,
+  std::uint8_t ChannelNum, std::uint8_t BufferCount, std::uint8_t RingBufferCount = BufferCount, bool Packed24Storage = false>
+class StaticI2SAudio final : public I2SAudio {
+  using super = I2SAudio;
+
+ public:
+  enum : std::size_t {
+    BufferLength = ((std::uint32_t)SampleRate * BufferMsec) / 1000,             ///< buffer length (samples)
+    PayloadSize = (ChannelNum * BufferLength) * ((AlignedBitLength + 7) / 8),  ///< buffer length (bytes)
+    StorageSize = Packed24Storage ? AudioPack24::packedSize(PayloadSize) : PayloadSize,  ///< リング 1 スロットのバイト数
+  };
+
+  /**
+   * @return buffer length (samples)
+   */
+  static constexpr std::size_t bufferLength() {
+    return BufferLength;
+  }
+
+  /**
+   * @return buffer length (bytes)
+   */
+  static constexpr std::size_t payloadSize() {
+    return PayloadSize;
+  }
+
+  static constexpr std::uint8_t bufferCount() {
+    return BufferCount;
+  }
+
+  static constexpr std::uint8_t ringBufferCount() {
+    return RingBufferCount;
+  }
+
+  static_assert(BitDepth <= AlignedBitLength, "AlignedBitLength must be >= BitDepth");
+  static_assert(0 < BufferLength, "buffer must hold at least one sample");
+  static_assert(0 < BufferCount && 0 < RingBufferCount, "buffer counts must be positive");
+  static_assert(!Packed24Storage || (BitDepth == 24 && AlignedBitLength == 32), "Packed24Storage needs 24-in-32 format");
+
+  /**
+   * @param [in] config I2S ハードウェア設定。
+   */
+  explicit StaticI2SAudio(const I2SAudioConfig& config) :
+    super(SampleRate, BitDepth, AlignedBitLength, BufferMsec, ChannelNum, BufferCount, storageConfig(config), RingBufferCount) {
+    useStaticBuffers(ringStorage, rxStorage, Packed24Storage ? scratchStorage : nullptr);
+  }
+
+  /**
+   * @brief フォーマットはテンプレート引数で固定しているので変更できない
+   * @return 常に false
+   */
+  bool reconfigure(std::uint16_t /*sampleRate*/, std::uint16_t /*bufferMsec*/) override {
+    return false;
+  }
+
+ private:
+  static I2SAudioConfig storageConfig(const I2SAudioConfig& config) {
+    I2SAudioConfig c = config;
+    c.packed24Storage = Packed24Storage;  // 静的領域の大きさと一致させる
+    return c;
+  }
+
+  alignas(4) char ringStorage[RingBufferCount * StorageSize];
+  alignas(4) char rxStorage[StorageSize];
+  std::int32_t scratchStorage[Packed24Storage ? PayloadSize / 4 : 1];
+};
+
+#endif  // LIB_ARDUINO_AUDIO_STATICI2SAUDIO_H_
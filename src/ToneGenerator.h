@@ -0,0 +1,100 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_TONEGENERATOR_H_
+#define LIB_ARDUINO_AUDIO_TONEGENERATOR_H_
+
+#include "AudioBlock.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 位相アキュムレータとテーブル補間によるトーン生成器 (DDS)
+ *
+ * サンプルごとに sin() を呼ばず、32bit 位相と 256 点の正弦テーブルの線形補間で生成する。
+ * 16bit PCM の payload 単位でまとめて書き出す。
+ */
+class ToneGenerator {
+ public:
+  enum Waveform {
+    Sine,
+    Square,
+    Triangle,
+    Sawtooth,
+  };
+
+  /**
+   * @param [in] sampleRate サンプリング周波数。
+   */
+  explicit ToneGenerator(std::uint16_t sampleRate);
+
+  /**
+   * @brief 単音を設定する
+   * @param [in] waveform 波形。
+   * @param [in] frequency 周波数 (Hz)。
+   * @param [in] amplitude 振幅。
+   */
+  void setTone(Waveform waveform, float frequency, std::int16_t amplitude);
+
+  /**
+   * @brief DTMF 信号 (低群と高群の 2 音) を設定する
+   * @param [in] key '0'-'9', '*', '#', 'A'-'D'。
+   * @param [in] amplitude 2 音合計の振幅。
+   * @return key が不正なとき false
+   */
+  bool setDtmf(char key, std::int16_t amplitude);
+
+  /**
+   * @brief 周波数スイープを設定する。終了後は endFrequency を保つ。
+   * @param [in] waveform 波形。
+   * @param [in] startFrequency 開始周波数 (Hz)。
+   * @param [in] endFrequency 終了周波数 (Hz)。
+   * @param [in] sweepMsec スイープ時間 (msec)。
+   * @param [in] amplitude 振幅。
+   */
+  void setSweep(Waveform waveform, float startFrequency, float endFrequency, std::uint32_t sweepMsec, std::int16_t amplitude);
+
+  /**
+   * @brief 無音にする
+   */
+  void silence();
+
+  /**
+   * @brief 位相を 0 に戻す
+   */
+  void reset();
+
+  /**
+   * @brief 16bit PCM をまとめて生成する
+   * @param [out] buffer 出力先。channelNum チャンネルのインターリーブ。
+   * @param [in] frames フレーム数。
+   * @param [in] channelNum チャンネル数。全チャンネルに同じ値を書く。
+   */
+  void render(std::int16_t* buffer, std::size_t frames, std::uint8_t channelNum = 1);
+
+  /**
+   * @brief ブロックの全チャンネルへ同じ値を生成する
+   */
+  void render(const AudioBlock<std::int16_t>& block);
+
+ private:
+  struct Oscillator {
+    std::uint32_t phase;
+    std::uint32_t increment;
+    std::int32_t incrementDelta;   ///< スイープ時の 1 サンプルあたり増分変化量
+    std::uint32_t sweepRemaining;  ///< スイープの残りサンプル数
+    std::int16_t amplitude;
+  };
+
+  std::uint32_t toIncrement(float frequency) const;
+  std::int32_t sample(Oscillator& osc) const;
+
+  const std::uint16_t sampleRate;
+  Waveform waveform;
+  std::uint8_t oscillatorNum;
+  Oscillator oscillators[2];
+};
+
+#endif  // LIB_ARDUINO_AUDIO_TONEGENERATOR_H_
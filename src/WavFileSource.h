@@ -0,0 +1,100 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_WAVFILESOURCE_H_
+#define LIB_ARDUINO_AUDIO_WAVFILESOURCE_H_
+
+#include "Audio.h"
+#include "AudioSource.h"
+#include "WavHeader.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+/**
+ * @brief WAV ファイルを先読みして出力形式の payload で返すソース
+ *
+ * 読み込みと形式変換 (ビット長、チャンネル数) は別タスクで行い、変換済みブロックをキューに溜める。
+ * オーディオループの read() はキューから 1 ブロック取り出してコピーするだけで、ストレージを待たない。
+ */
+class WavFileSource : public AudioSource {
+ public:
+  /**
+   * @param [in] output 出力先。payload 長とフォーマットをここから決める。
+   * @param [in] blockCount 先読みするブロック数。ストレージの最悪読み込み時間 / 周期 より多くする。
+   */
+  WavFileSource(const Audio& output, std::uint8_t blockCount);
+  ~WavFileSource();
+
+  /**
+   * @brief ファイルを開き、ヘッダを検証して先読みを開始する
+   *
+   * サンプリング周波数は出力と一致している必要がある。ビット長 (8/16/24/32) と
+   * チャンネル数 (モノラル複製/ステレオ平均) は変換する。
+   * @param [in] path fopen() で開けるパス。
+   * @param [in] priority 読み込みタスクの優先度。
+   * @return 開始できたとき true
+   */
+  bool open(const char* path, UBaseType_t priority = 2);
+
+  /**
+   * @brief 先読みを止めてファイルを閉じる
+   */
+  void close();
+
+  std::size_t read(std::uint8_t* buffer, std::size_t byteLength) override;
+  bool finished() const override;
+
+  const WavHeader& getHeader() const;
+
+  /**
+   * @return 先読み済みのブロック数
+   */
+  std::uint8_t getReadyBlocks() const;
+
+  /**
+   * @return 1 ブロックの読み込み+変換にかかった最大時間 (usec)
+   */
+  std::uint32_t getMaxFetchMicros() const;
+
+  /**
+   * @return 1 周期より長くかかった読み込みの回数。同期読み込みなら途切れていた回数。
+   */
+  std::uint32_t getHiddenStalls() const;
+
+  /**
+   * @return read() の時点で先読みが間に合っていなかった回数
+   */
+  std::uint32_t getUnderflows() const;
+
+ private:
+  static void readerTask(void* arg);
+  void readLoop();
+  std::size_t fetch(std::uint8_t* block);
+
+  const std::uint16_t sampleRate;
+  const std::size_t payloadSize;
+  const std::size_t frames;
+  const std::uint8_t outChannels;
+  const std::uint8_t outBytes;
+  const std::uint32_t periodMicros;
+  const std::uint8_t blockCount;
+  std::uint8_t* const pool;
+  std::size_t* const blockLength;
+  QueueHandle_t freeQueue;
+  QueueHandle_t readyQueue;
+  SemaphoreHandle_t readerDone;
+  FILE* file;
+  WavHeader header;
+  std::uint8_t* raw;              ///< ファイルから読んだ 1 ブロック分の生データ
+  std::uint32_t remainingBytes;   ///< data チャンクの残り
+  volatile bool eof;
+
+  volatile std::uint32_t maxFetchMicros;
+  volatile std::uint32_t hiddenStalls;
+  std::uint32_t underflows;
+};
+
+#endif  // LIB_ARDUINO_AUDIO_WAVFILESOURCE_H_
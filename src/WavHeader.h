@@ -0,0 +1,44 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#ifndef LIB_ARDUINO_AUDIO_WAVHEADER_H_
+#define LIB_ARDUINO_AUDIO_WAVHEADER_H_
+
+#include <cstdint>
+#include <stdio.h>
+
+/**
+ * @brief リニア PCM の WAV (RIFF) ヘッダ
+ */
+struct WavHeader {
+  std::uint16_t channels;
+  std::uint32_t sampleRate;
+  std::uint16_t bitsPerSample;  ///< 1 サンプルの格納ビット数 (8/16/24/32)
+  std::uint32_t dataBytes;      ///< data チャンクのバイト数
+  long dataOffset;              ///< ファイル先頭から data チャンク本体までのバイト数
+
+  /**
+   * @return 1 フレームのバイト数
+   */
+  std::uint16_t getBlockAlign() const {
+    return channels * ((bitsPerSample + 7) / 8);
+  }
+
+  /**
+   * @brief 44 バイトの標準ヘッダをファイル先頭に書く。dataOffset は 44 になる。
+   * @return 書き込めたとき true
+   */
+  bool write(FILE* file);
+
+  /**
+   * @brief ヘッダを読み、ファイル位置を data チャンク本体の先頭に合わせる
+   *
+   * fmt/data 以外のチャンクは読み飛ばす。リニア PCM (WAVE_FORMAT_PCM, WAVE_FORMAT_EXTENSIBLE) のみ受け付ける。
+   * @return 読めたとき true
+   */
+  bool read(FILE* file);
+};
+
+#endif  // LIB_ARDUINO_AUDIO_WAVHEADER_H_
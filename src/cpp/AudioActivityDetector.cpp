@@ -0,0 +1,82 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../AudioActivityDetector.h"
+
+AudioActivityDetector::AudioActivityDetector(std::int32_t threshold, std::uint16_t hangoverPeriods) :
+  threshold(threshold), hangoverPeriods(hangoverPeriods) {
+  reset();
+}
+
+void AudioActivityDetector::reset() {
+  hangover = 0;
+  active = false;
+  activePeriods = 0;
+  silentPeriods = 0;
+}
+
+template<class T>
+bool AudioActivityDetector::detect(const AudioBlock<const T>& block, int shift) const {
+  // 平均絶対値 > threshold <=> 絶対値の総和 > threshold * samples。超えた時点で打ち切る
+  const std::uint32_t limit = (std::uint32_t)threshold * block.samples();
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; i < block.frames; i++) {
+    const T* f = block.frame(i);
+    for (std::uint8_t c = 0; c < block.channels; c++) {
+      const std::int32_t v = (std::int32_t)f[c] >> shift;
+      sum += (std::uint32_t)(v < 0 ? -v : v);
+    }
+    if (limit < sum) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AudioActivityDetector::commit(bool voiced) {
+  if (voiced) {
+    hangover = hangoverPeriods;
+    active = true;
+  } else if (0 < hangover) {
+    hangover--;
+    active = true;
+  } else {
+    active = false;
+  }
+  if (active) {
+    activePeriods++;
+  } else {
+    silentPeriods++;
+  }
+  return active;
+}
+
+bool AudioActivityDetector::update(const AudioBlock<const std::int16_t>& block) {
+  return commit(detect(block, 0));
+}
+
+bool AudioActivityDetector::update(const AudioBlock<const std::int32_t>& block) {
+  return commit(detect(block, 16));
+}
+
+bool AudioActivityDetector::isActive() const {
+  return active;
+}
+
+void AudioActivityDetector::setThreshold(std::int32_t t) {
+  threshold = t;
+}
+
+void AudioActivityDetector::setHangover(std::uint16_t periods) {
+  hangoverPeriods = periods;
+}
+
+std::uint32_t AudioActivityDetector::getActivePeriods() const {
+  return activePeriods;
+}
+
+std::uint32_t AudioActivityDetector::getSilentPeriods() const {
+  return silentPeriods;
+}
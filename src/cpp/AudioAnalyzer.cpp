@@ -0,0 +1,91 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../AudioAnalyzer.h"
+#include <math.h>
+
+AudioAnalyzer::AudioAnalyzer(std::size_t fftSize) :
+  fft(fftSize ? new AudioFft(fftSize) : nullptr),
+  window(fftSize ? new float[fftSize] : nullptr),
+  work(fftSize ? new float[fftSize] : nullptr),
+  spectrum(fftSize ? new float[fftSize / 2 + 1] : nullptr),
+  fftChannel(0), levels(), periodCount(0) {
+  for (std::size_t i = 0; i < fftSize; i++) {
+    window[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * i / fftSize));
+  }
+  for (std::size_t i = 0; fftSize && i <= fftSize / 2; i++) {
+    spectrum[i] = 0.0f;
+  }
+}
+
+AudioAnalyzer::~AudioAnalyzer() {
+  delete fft;
+  delete[] window;
+  delete[] work;
+  delete[] spectrum;
+}
+
+void AudioAnalyzer::analyze(const AudioBlock<const std::int16_t>& block) {
+  analyzeBlock(block);
+}
+
+void AudioAnalyzer::analyze(const AudioBlock<const std::int32_t>& block) {
+  analyzeBlock(block);
+}
+
+template<class T>
+void AudioAnalyzer::analyzeBlock(const AudioBlock<const T>& block) {
+  const std::uint8_t channels = block.channels < MaxChannels ? block.channels : MaxChannels;
+  for (std::uint8_t c = 0; c < channels; c++) {
+    std::int32_t peak = 0;
+    float sum = 0.0f;
+    const T* p = block.data + c;
+    for (std::size_t i = 0; i < block.frames; i++, p += block.stride) {
+      const std::int32_t v = *p;
+      const std::int32_t a = v < 0 ? ((v == INT32_MIN) ? INT32_MAX : -v) : v;
+      peak = peak < a ? a : peak;
+      sum += (float)v * (float)v;
+    }
+    levels[c].peak = peak;
+    levels[c].rms = block.frames ? sqrtf(sum / block.frames) : 0.0f;
+  }
+
+  if (fft && fftChannel < block.channels) {
+    // 周期長が FFT 点数に満たない分は 0 埋め、超える分は捨てる
+    const std::size_t n = fft->getSize();
+    const std::size_t m = block.frames < n ? block.frames : n;
+    const T* p = block.data + fftChannel;
+    std::size_t i = 0;
+    for (; i < m; i++, p += block.stride) {
+      work[i] = (float)*p * window[i];
+    }
+    for (; i < n; i++) {
+      work[i] = 0.0f;
+    }
+    fft->forward(work);
+    fft->power(work, spectrum);
+  }
+  periodCount++;
+}
+
+void AudioAnalyzer::setFftChannel(std::uint8_t channel) {
+  fftChannel = channel;
+}
+
+const AudioAnalyzer::Level& AudioAnalyzer::getLevel(std::uint8_t channel) const {
+  return levels[channel < MaxChannels ? channel : 0];
+}
+
+const float* AudioAnalyzer::getSpectrum() const {
+  return spectrum;
+}
+
+std::size_t AudioAnalyzer::getSpectrumLength() const {
+  return fft ? fft->getSize() / 2 + 1 : 0;
+}
+
+std::uint32_t AudioAnalyzer::getPeriodCount() const {
+  return periodCount;
+}
@@ -0,0 +1,94 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../AudioBenchmark.h"
+#include <Arduino.h>
+#include <algorithm>
+
+#ifdef ARDUINO_ARCH_ESP32
+static std::uint32_t readTicks() {
+  return ESP.getCycleCount();
+}
+
+static std::uint64_t ticksToNsec(std::uint64_t t) {
+  return t * 1000 / getCpuFrequencyMhz();
+}
+#else
+#include <time.h>
+
+static std::uint32_t readTicks() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (std::uint32_t)((std::uint64_t)t.tv_sec * 1000000000 + t.tv_nsec);  // 差だけ使うので桁あふれしてよい
+}
+
+static std::uint64_t ticksToNsec(std::uint64_t t) {
+  return t;
+}
+#endif
+
+AudioBenchmark::AudioBenchmark(const char* name, std::size_t samplesPerRun, std::size_t bytesPerRun, std::size_t maxRuns) :
+  name(name), samplesPerRun(samplesPerRun), bytesPerRun(bytesPerRun), maxRuns(maxRuns),
+  ticks(new std::uint32_t[maxRuns]) {
+  reset();
+}
+
+AudioBenchmark::~AudioBenchmark() {
+  delete[] ticks;
+}
+
+void AudioBenchmark::reset() {
+  runs = 0;
+  totalTicks = 0;
+  startTicks = 0;
+}
+
+void AudioBenchmark::begin() {
+  startTicks = readTicks();
+}
+
+void AudioBenchmark::end() {
+  const std::uint32_t t = readTicks() - startTicks;
+  if (runs < maxRuns) {
+    ticks[runs++] = t;
+    totalTicks += t;
+  }
+}
+
+std::size_t AudioBenchmark::getRuns() const {
+  return runs;
+}
+
+std::uint32_t AudioBenchmark::getPercentileNsec(std::uint8_t percent) const {
+  if (runs == 0) {
+    return 0;
+  }
+  std::uint32_t sorted[runs];
+  std::copy(ticks, ticks + runs, sorted);
+  std::sort(sorted, sorted + runs);
+  const std::size_t index = std::min(runs - 1, (runs * percent) / 100);
+  return (std::uint32_t)ticksToNsec(sorted[index]);
+}
+
+float AudioBenchmark::getNsecPerSample() const {
+  if (runs == 0 || samplesPerRun == 0) {
+    return 0.0f;
+  }
+  return (float)ticksToNsec(totalTicks) / ((float)runs * samplesPerRun);
+}
+
+void AudioBenchmark::printHeader(Print& out) {
+  out.printf("%-24s %6s %10s %9s %9s %9s %9s %9s\n",
+    "name", "runs", "ns/sample", "MB/s", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+}
+
+void AudioBenchmark::report(Print& out) const {
+  const float nsPerSample = getNsecPerSample();
+  const float bytesPerNsec = (runs == 0) ? 0.0f : (float)bytesPerRun * runs / (float)ticksToNsec(totalTicks);
+  out.printf("%-24s %6u %10.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+    name, (unsigned)runs, nsPerSample, bytesPerNsec * 1000.0f,
+    getPercentileNsec(50) / 1000.0f, getPercentileNsec(90) / 1000.0f,
+    getPercentileNsec(99) / 1000.0f, getPercentileNsec(100) / 1000.0f);
+}
@@ -0,0 +1,113 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../AudioFft.h"
+#include <math.h>
+
+AudioFft::AudioFft(std::size_t size) :
+  size(size), twiddle(new float[size]), bitReverse(new std::uint16_t[size / 2]) {
+  const std::size_t half = size / 2;
+  for (std::size_t k = 0; k < half; k++) {
+    const double a = -2.0 * M_PI * k / size;
+    twiddle[2 * k] = (float)cos(a);
+    twiddle[2 * k + 1] = (float)sin(a);
+  }
+  std::size_t bits = 0;
+  while (((std::size_t)1 << bits) < half) {
+    bits++;
+  }
+  for (std::size_t i = 0; i < half; i++) {
+    std::size_t r = 0;
+    for (std::size_t b = 0; b < bits; b++) {
+      r |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    bitReverse[i] = (std::uint16_t)r;
+  }
+}
+
+AudioFft::~AudioFft() {
+  delete[] twiddle;
+  delete[] bitReverse;
+}
+
+std::size_t AudioFft::getSize() const {
+  return size;
+}
+
+void AudioFft::forward(float* data) const {
+  const std::size_t half = size / 2;
+
+  // 偶数/奇数番目を実部/虚部とみなした N/2 点複素列をビット反転順に並べ替える
+  for (std::size_t i = 0; i < half; i++) {
+    const std::size_t j = bitReverse[i];
+    if (i < j) {
+      const float re = data[2 * i];
+      const float im = data[2 * i + 1];
+      data[2 * i] = data[2 * j];
+      data[2 * i + 1] = data[2 * j + 1];
+      data[2 * j] = re;
+      data[2 * j + 1] = im;
+    }
+  }
+
+  // radix-2 DIT バタフライ。N/2 点 FFT の回転因子は N 点用の表を 2 つ飛びで使う
+  for (std::size_t len = 2; len <= half; len <<= 1) {
+    const std::size_t step = size / len;
+    const std::size_t hl = len / 2;
+    for (std::size_t base = 0; base < half; base += len) {
+      for (std::size_t k = 0; k < hl; k++) {
+        const float wr = twiddle[2 * (k * step)];
+        const float wi = twiddle[2 * (k * step) + 1];
+        float* a = data + 2 * (base + k);
+        float* b = data + 2 * (base + k + hl);
+        const float tr = b[0] * wr - b[1] * wi;
+        const float ti = b[0] * wi + b[1] * wr;
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+      }
+    }
+  }
+
+  // 複素 FFT 結果 Z から実数列の X を組み立てる
+  const float z0r = data[0];
+  const float z0i = data[1];
+  data[0] = z0r + z0i;  // X[0]
+  data[1] = z0r - z0i;  // X[N/2]
+  for (std::size_t k = 1; k <= half / 2; k++) {
+    const std::size_t m = half - k;
+    const float ar = data[2 * k];
+    const float ai = data[2 * k + 1];
+    const float br = data[2 * m];
+    const float bi = data[2 * m + 1];
+    // E = (Z[k] + conj(Z[m]))/2, O = (Z[k] - conj(Z[m]))/2
+    const float er = 0.5f * (ar + br);
+    const float ei = 0.5f * (ai - bi);
+    const float or_ = 0.5f * (ar - br);
+    const float oi = 0.5f * (ai + bi);
+    const float wr = twiddle[2 * k];
+    const float wi = twiddle[2 * k + 1];
+    // X[k] = E + (-i) W^k O', O' = (oi, -or) を回転したもの
+    const float tr = oi * wr + or_ * wi;
+    const float ti = oi * wi - or_ * wr;
+    data[2 * k] = er + tr;
+    data[2 * k + 1] = ei + ti;
+    if (m != k) {
+      // X[m] = conj(E) - conj(... ) の対称性から求める
+      data[2 * m] = er - tr;
+      data[2 * m + 1] = -(ei - ti);
+    }
+  }
+}
+
+void AudioFft::power(const float* packed, float* out) const {
+  const std::size_t half = size / 2;
+  out[0] = packed[0] * packed[0];
+  out[half] = packed[1] * packed[1];
+  for (std::size_t k = 1; k < half; k++) {
+    out[k] = packed[2 * k] * packed[2 * k] + packed[2 * k + 1] * packed[2 * k + 1];
+  }
+}
@@ -0,0 +1,90 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../AudioGain.h"
+#include <string.h>
+
+AudioGain::AudioGain() :
+  rampMode(RampLinear), volume(Unity), muted(false), ramping(false),
+  current((std::int32_t)Unity << FracShift), targetValue((std::int32_t)Unity << FracShift),
+  step(0), remaining(0), expShift(0) {
+}
+
+void AudioGain::setTarget(std::uint16_t gain, std::uint32_t rampSamples) {
+  volume = gain;
+  updateRamp(rampSamples);
+}
+
+void AudioGain::setMute(bool mute, std::uint32_t rampSamples) {
+  muted = mute;
+  updateRamp(rampSamples);
+}
+
+void AudioGain::setRampMode(RampMode mode) {
+  rampMode = mode;
+}
+
+std::uint16_t AudioGain::getTarget() const {
+  return volume;
+}
+
+bool AudioGain::isMuted() const {
+  return muted;
+}
+
+void AudioGain::process(const AudioBlock<std::int16_t>& block) {
+  if (isUnity()) {
+    return;
+  }
+  if (isSilent()) {
+    if (block.isContiguous()) {
+      memset(block.data, 0, block.byteSize());
+    } else {
+      for (std::size_t i = 0; i < block.frames; i++) {
+        memset(block.frame(i), 0, block.channels * sizeof(std::int16_t));
+      }
+    }
+    return;
+  }
+  if (!ramping) {
+    // 一定ゲイン: ループ内の分岐を無くす
+    const std::int32_t g = current >> FracShift;
+    for (std::size_t i = 0; i < block.frames; i++) {
+      std::int16_t* f = block.frame(i);
+      for (std::uint8_t c = 0; c < block.channels; c++) {
+        f[c] = apply(f[c], g);
+      }
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < block.frames; i++) {
+    const std::int32_t g = next();
+    std::int16_t* f = block.frame(i);
+    for (std::uint8_t c = 0; c < block.channels; c++) {
+      f[c] = apply(f[c], g);
+    }
+  }
+}
+
+void AudioGain::updateRamp(std::uint32_t rampSamples) {
+  targetValue = (std::int32_t)(muted ? 0 : volume) << FracShift;
+  if (rampSamples == 0 || targetValue == current) {
+    current = targetValue;
+    ramping = false;
+    return;
+  }
+  // linear: rampSamples で到達。exponential: 時定数を rampSamples/4 程度にして rampSamples でほぼ収束させる
+  step = (targetValue - current) / (std::int32_t)rampSamples;
+  remaining = rampSamples;
+  if (step == 0) {
+    step = (targetValue < current) ? -1 : 1;
+    remaining = (std::uint32_t)((targetValue < current) ? current - targetValue : targetValue - current);
+  }
+  expShift = 0;
+  while (expShift < 16 && ((std::uint32_t)4 << expShift) < rampSamples) {
+    expShift++;
+  }
+  ramping = true;
+}
@@ -7,15 +7,24 @@
 #include <Arduino.h>
 
 AudioImpl::AudioImpl(std::uint16_t sampleRate, std::uint8_t bitDepth, std::uint8_t bitLength, std::uint16_t bufferMsec, std::uint8_t channelNum):
+  renderCallback(nullptr), renderCallbackArg(nullptr), captureCallback(nullptr), captureCallbackArg(nullptr),
   sampleRate(sampleRate), bitDepth(bitDepth), bitLength(bitLength), bufferMsec(bufferMsec), channelNum(channelNum),
   bufferLength(((std::uint32_t)sampleRate * bufferMsec) / 1000),
   payloadLength((channelNum*bufferLength)*((bitLength+7)/8)) {
 }
 
 AudioImpl::AudioImpl(Audio* audio) :
+  renderCallback(nullptr), renderCallbackArg(nullptr), captureCallback(nullptr), captureCallbackArg(nullptr),
   sampleRate(audio->getSampRate()), bitDepth(audio->getBitDepth()), bitLength(audio->getAlignedBitLength()), bufferMsec(audio->getBufferMsec()), channelNum(audio->getChannelNum()),
   bufferLength(audio->getBufferLength()),
-  payloadLength(audio->getPayloadSize()){
+  payloadLength(audio->getPayloadSize()) {
+}
+
+void AudioImpl::setFormat(std::uint16_t sampleRate, std::uint16_t bufferMsec) {
+  this->sampleRate = sampleRate;
+  this->bufferMsec = bufferMsec;
+  bufferLength = ((std::uint32_t)sampleRate * bufferMsec) / 1000;
+  payloadLength = (channelNum * bufferLength) * ((bitLength + 7) / 8);
 }
 
 std::uint16_t AudioImpl::getSampRate() const {
@@ -65,3 +74,33 @@ bool AudioImpl::waitForReadable(std::uint32_t /*maxWaitMsec*/) {
   }
   return readable;
 }
+
+bool AudioImpl::setRenderCallback(RenderCallback callback, void* arg) {
+  renderCallback = callback;
+  renderCallbackArg = arg;
+  return true;
+}
+
+bool AudioImpl::setCaptureCallback(CaptureCallback callback, void* arg) {
+  captureCallback = callback;
+  captureCallbackArg = arg;
+  return true;
+}
+
+bool AudioImpl::process(std::uint32_t maxWaitMsec) {
+  bool done = false;
+  if (renderCallback && waitForWritable(maxWaitMsec)) {
+    std::uint8_t tmp[getPayloadSize()];
+    renderCallback(tmp, getBufferLength(), renderCallbackArg);
+    write(tmp, getPayloadSize());
+    done = true;
+  }
+  if (captureCallback && waitForReadable(maxWaitMsec)) {
+    std::uint8_t tmp[getPayloadSize()];
+    if (0 < read(tmp, getPayloadSize())) {
+      captureCallback(tmp, getBufferLength(), captureCallbackArg);
+      done = true;
+    }
+  }
+  return done;
+}
@@ -0,0 +1,148 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../AudioRecorder.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define WRITER_STOP 0xFF  // fullQueue に積むと書き込みタスクが終了する
+
+AudioRecorder::AudioRecorder(std::size_t blockSize, std::uint8_t blockCount) :
+  blockSize(blockSize), blockCount(blockCount < WRITER_STOP ? blockCount : WRITER_STOP - 1),
+  pool(new std::uint8_t[blockSize * blockCount]), blockLength(new std::size_t[blockCount]),
+  freeQueue(xQueueCreate(blockCount, sizeof(std::uint8_t))),
+  fullQueue(xQueueCreate(blockCount + 1, sizeof(std::uint8_t))),
+  writerDone(xSemaphoreCreateBinary()),
+  file(nullptr), header(), writtenBlocks(0), droppedBlocks(0), writtenBytes(0), maxWriteMicros(0), totalWriteMicros(0) {
+}
+
+AudioRecorder::~AudioRecorder() {
+  close();
+  vQueueDelete(freeQueue);
+  vQueueDelete(fullQueue);
+  vSemaphoreDelete(writerDone);
+  delete[] pool;
+  delete[] blockLength;
+}
+
+bool AudioRecorder::open(const char* path, const Audio& audio, UBaseType_t priority) {
+  if (file) {
+    return false;
+  }
+  file = fopen(path, "wb");
+  if (!file) {
+    log_e("AudioRecorder: cannot open %s", path);
+    return false;
+  }
+  header.channels = audio.getChannelNum();
+  header.sampleRate = audio.getSampRate();
+  header.bitsPerSample = audio.getAlignedBitLength();
+  header.dataBytes = 0;
+  if (!header.write(file)) {
+    fclose(file);
+    file = nullptr;
+    return false;
+  }
+  xQueueReset(freeQueue);
+  xQueueReset(fullQueue);
+  for (std::uint8_t i = 0; i < blockCount; i++) {
+    xQueueSend(freeQueue, &i, 0);
+  }
+  writtenBlocks = 0;
+  droppedBlocks = 0;
+  writtenBytes = 0;
+  maxWriteMicros = 0;
+  totalWriteMicros = 0;
+  if (xTaskCreate(writerTask, "AudioRecorder", 4096, this, priority, nullptr) != pdPASS) {
+    fclose(file);
+    file = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool AudioRecorder::push(const std::uint8_t* data, std::size_t length) {
+  if (!file) {
+    return false;
+  }
+  std::uint8_t index;
+  if (xQueueReceive(freeQueue, &index, 0) != pdTRUE) {
+    droppedBlocks++;  // 書き込みが追いついていない。録音側は待たずに捨てる
+    return false;
+  }
+  const std::size_t n = length < blockSize ? length : blockSize;
+  memcpy(pool + index * blockSize, data, n);
+  blockLength[index] = n;
+  xQueueSend(fullQueue, &index, 0);
+  return true;
+}
+
+void AudioRecorder::close() {
+  if (!file) {
+    return;
+  }
+  const std::uint8_t stop = WRITER_STOP;
+  xQueueSend(fullQueue, &stop, portMAX_DELAY);
+  xSemaphoreTake(writerDone, portMAX_DELAY);
+  header.dataBytes = (std::uint32_t)writtenBytes;
+  header.write(file);  // data サイズを確定する
+  fclose(file);
+  file = nullptr;
+}
+
+void AudioRecorder::captureCallback(const std::uint8_t* buffer, std::size_t /*frames*/, void* arg) {
+  AudioRecorder* recorder = static_cast<AudioRecorder*>(arg);
+  recorder->push(buffer, recorder->blockSize);
+}
+
+void AudioRecorder::writerTask(void* arg) {
+  static_cast<AudioRecorder*>(arg)->writeLoop();
+  vTaskDelete(nullptr);
+}
+
+void AudioRecorder::writeLoop() {
+  std::uint8_t index;
+  while (xQueueReceive(fullQueue, &index, portMAX_DELAY) == pdTRUE && index != WRITER_STOP) {
+    const std::uint32_t start = micros();
+    const std::size_t n = fwrite(pool + index * blockSize, 1, blockLength[index], file);
+    const std::uint32_t elapsed = micros() - start;
+    if (n < blockLength[index]) {
+      log_e("AudioRecorder: write error");
+    }
+    xQueueSend(freeQueue, &index, 0);
+    writtenBlocks++;
+    writtenBytes += n;
+    totalWriteMicros += elapsed;
+    if (maxWriteMicros < elapsed) {
+      maxWriteMicros = elapsed;
+    }
+  }
+  fflush(file);
+  xSemaphoreGive(writerDone);
+}
+
+bool AudioRecorder::isOpen() const {
+  return file != nullptr;
+}
+
+std::uint32_t AudioRecorder::getWrittenBlocks() const {
+  return writtenBlocks;
+}
+
+std::uint32_t AudioRecorder::getDroppedBlocks() const {
+  return droppedBlocks;
+}
+
+std::uint64_t AudioRecorder::getWrittenBytes() const {
+  return writtenBytes;
+}
+
+std::uint32_t AudioRecorder::getMaxWriteMicros() const {
+  return maxWriteMicros;
+}
+
+std::uint32_t AudioRecorder::getThroughput() const {
+  return totalWriteMicros ? (std::uint32_t)(writtenBytes * 1000000 / totalWriteMicros) : 0;
+}
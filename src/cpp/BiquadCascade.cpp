@@ -0,0 +1,226 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../BiquadCascade.h"
+#include <math.h>
+#include <string.h>
+
+BiquadCascade::BiquadCascade(std::uint32_t sampleRate) :
+  sampleRate(sampleRate), sectionCount(0), coeffs(), fixedCoeffs(), floatState(), fixedState() {
+}
+
+static std::int32_t toFixed(float c) {
+  const float scaled = c * (float)(1 << BiquadCascade::CoeffShift);
+  const float limit = 2147483647.0f;
+  return (std::int32_t)(scaled < -limit ? -limit : (limit < scaled ? limit : scaled));
+}
+
+bool BiquadCascade::setSection(std::uint8_t index, const Coefficients& c) {
+  if (sectionCount <= index) {
+    return false;
+  }
+  coeffs[index] = c;
+  fixedCoeffs[index][0] = toFixed(c.b0);
+  fixedCoeffs[index][1] = toFixed(c.b1);
+  fixedCoeffs[index][2] = toFixed(c.b2);
+  fixedCoeffs[index][3] = toFixed(c.a1);
+  fixedCoeffs[index][4] = toFixed(c.a2);
+  return true;
+}
+
+bool BiquadCascade::addSection(const Coefficients& c) {
+  if (MaxSections <= sectionCount) {
+    return false;
+  }
+  const std::uint8_t index = sectionCount++;
+  memset(floatState[index], 0, sizeof(floatState[index]));
+  memset(fixedState[index], 0, sizeof(fixedState[index]));
+  return setSection(index, c);
+}
+
+bool BiquadCascade::addPeaking(float frequency, float q, float gainDb) {
+  return addSection(peaking(sampleRate, frequency, q, gainDb));
+}
+
+bool BiquadCascade::addLowShelf(float frequency, float q, float gainDb) {
+  return addSection(lowShelf(sampleRate, frequency, q, gainDb));
+}
+
+bool BiquadCascade::addHighShelf(float frequency, float q, float gainDb) {
+  return addSection(highShelf(sampleRate, frequency, q, gainDb));
+}
+
+bool BiquadCascade::addHighPass(float frequency, float q) {
+  return addSection(highPass(sampleRate, frequency, q));
+}
+
+bool BiquadCascade::addLowPass(float frequency, float q) {
+  return addSection(lowPass(sampleRate, frequency, q));
+}
+
+void BiquadCascade::clear() {
+  sectionCount = 0;
+}
+
+void BiquadCascade::reset() {
+  memset(floatState, 0, sizeof(floatState));
+  memset(fixedState, 0, sizeof(fixedState));
+}
+
+std::uint8_t BiquadCascade::getSectionCount() const {
+  return sectionCount;
+}
+
+std::uint32_t BiquadCascade::getSampRate() const {
+  return sampleRate;
+}
+
+void BiquadCascade::process(const AudioBlock<float>& block) {
+  if (block.channels == 1) {
+    processFloat<1>(block);
+  } else {
+    processFloat<MaxChannels>(block);
+  }
+}
+
+void BiquadCascade::process(const AudioBlock<std::int16_t>& block) {
+  // 段の間を Q31 で受け渡すため、短い区間ずつ 32bit へ広げて処理する
+  const std::size_t chunk = 32;
+  const std::uint8_t channels = block.channels < MaxChannels ? block.channels : MaxChannels;
+  std::int32_t tmp[chunk * MaxChannels];
+  for (std::size_t i = 0; i < block.frames; i += chunk) {
+    const std::size_t n = block.frames - i < chunk ? block.frames - i : chunk;
+    for (std::size_t j = 0; j < n; j++) {
+      for (std::uint8_t ch = 0; ch < channels; ch++) {
+        tmp[j * channels + ch] = (std::int32_t)((std::uint32_t)(std::uint16_t)block.frame(i + j)[ch] << 16);
+      }
+    }
+    process(AudioBlock<std::int32_t>(tmp, n, channels));
+    for (std::size_t j = 0; j < n; j++) {
+      for (std::uint8_t ch = 0; ch < channels; ch++) {
+        block.frame(i + j)[ch] = (std::int16_t)(tmp[j * channels + ch] >> 16);
+      }
+    }
+  }
+}
+
+void BiquadCascade::process(const AudioBlock<std::int32_t>& block) {
+  if (block.channels == 1) {
+    processFixed<1>(block);
+  } else {
+    processFixed<MaxChannels>(block);
+  }
+}
+
+template<std::uint8_t Channels>
+void BiquadCascade::processFloat(const AudioBlock<float>& block) {
+  for (std::uint8_t s = 0; s < sectionCount; s++) {
+    const Coefficients c = coeffs[s];
+    float z1[Channels];
+    float z2[Channels];
+    for (std::uint8_t ch = 0; ch < Channels; ch++) {
+      z1[ch] = floatState[s][ch][0];
+      z2[ch] = floatState[s][ch][1];
+    }
+    float* p = block.data;
+    for (std::size_t i = 0; i < block.frames; i++, p += block.stride) {
+      for (std::uint8_t ch = 0; ch < Channels; ch++) {
+        const float x = p[ch];
+        const float y = c.b0 * x + z1[ch];
+        z1[ch] = c.b1 * x - c.a1 * y + z2[ch];
+        z2[ch] = c.b2 * x - c.a2 * y;
+        p[ch] = y;
+      }
+    }
+    for (std::uint8_t ch = 0; ch < Channels; ch++) {
+      floatState[s][ch][0] = z1[ch];
+      floatState[s][ch][1] = z2[ch];
+    }
+  }
+}
+
+template<std::uint8_t Channels>
+void BiquadCascade::processFixed(const AudioBlock<std::int32_t>& block) {
+  const std::int64_t max = INT32_MAX;
+  const std::int64_t min = INT32_MIN;
+  for (std::uint8_t s = 0; s < sectionCount; s++) {
+    const std::int64_t b0 = fixedCoeffs[s][0];
+    const std::int64_t b1 = fixedCoeffs[s][1];
+    const std::int64_t b2 = fixedCoeffs[s][2];
+    const std::int64_t a1 = fixedCoeffs[s][3];
+    const std::int64_t a2 = fixedCoeffs[s][4];
+    std::int32_t x1[Channels], x2[Channels], y1[Channels], y2[Channels];
+    for (std::uint8_t ch = 0; ch < Channels; ch++) {
+      x1[ch] = fixedState[s][ch][0];
+      x2[ch] = fixedState[s][ch][1];
+      y1[ch] = fixedState[s][ch][2];
+      y2[ch] = fixedState[s][ch][3];
+    }
+    std::int32_t* p = block.data;
+    for (std::size_t i = 0; i < block.frames; i++, p += block.stride) {
+      for (std::uint8_t ch = 0; ch < Channels; ch++) {
+        const std::int32_t x = p[ch];
+        std::int64_t acc = b0 * x + b1 * x1[ch] + b2 * x2[ch] - a1 * y1[ch] - a2 * y2[ch];
+        acc >>= CoeffShift;
+        const std::int32_t y = (std::int32_t)(acc < min ? min : (max < acc ? max : acc));
+        x2[ch] = x1[ch];
+        x1[ch] = x;
+        y2[ch] = y1[ch];
+        y1[ch] = y;
+        p[ch] = y;
+      }
+    }
+    for (std::uint8_t ch = 0; ch < Channels; ch++) {
+      fixedState[s][ch][0] = x1[ch];
+      fixedState[s][ch][1] = x2[ch];
+      fixedState[s][ch][2] = y1[ch];
+      fixedState[s][ch][3] = y2[ch];
+    }
+  }
+}
+
+static BiquadCascade::Coefficients normalize(double b0, double b1, double b2, double a0, double a1, double a2) {
+  return BiquadCascade::Coefficients{
+    (float)(b0 / a0), (float)(b1 / a0), (float)(b2 / a0), (float)(a1 / a0), (float)(a2 / a0)};
+}
+
+BiquadCascade::Coefficients BiquadCascade::peaking(std::uint32_t sampleRate, float frequency, float q, float gainDb) {
+  const double a = pow(10.0, gainDb / 40.0);
+  const double w = 2.0 * M_PI * frequency / sampleRate;
+  const double alpha = sin(w) / (2.0 * q);
+  return normalize(1.0 + alpha * a, -2.0 * cos(w), 1.0 - alpha * a, 1.0 + alpha / a, -2.0 * cos(w), 1.0 - alpha / a);
+}
+
+BiquadCascade::Coefficients BiquadCascade::lowShelf(std::uint32_t sampleRate, float frequency, float q, float gainDb) {
+  const double a = pow(10.0, gainDb / 40.0);
+  const double w = 2.0 * M_PI * frequency / sampleRate;
+  const double cw = cos(w);
+  const double beta = 2.0 * sqrt(a) * sin(w) / (2.0 * q);
+  return normalize(a * ((a + 1.0) - (a - 1.0) * cw + beta), 2.0 * a * ((a - 1.0) - (a + 1.0) * cw), a * ((a + 1.0) - (a - 1.0) * cw - beta),
+                   (a + 1.0) + (a - 1.0) * cw + beta, -2.0 * ((a - 1.0) + (a + 1.0) * cw), (a + 1.0) + (a - 1.0) * cw - beta);
+}
+
+BiquadCascade::Coefficients BiquadCascade::highShelf(std::uint32_t sampleRate, float frequency, float q, float gainDb) {
+  const double a = pow(10.0, gainDb / 40.0);
+  const double w = 2.0 * M_PI * frequency / sampleRate;
+  const double cw = cos(w);
+  const double beta = 2.0 * sqrt(a) * sin(w) / (2.0 * q);
+  return normalize(a * ((a + 1.0) + (a - 1.0) * cw + beta), -2.0 * a * ((a - 1.0) + (a + 1.0) * cw), a * ((a + 1.0) + (a - 1.0) * cw - beta),
+                   (a + 1.0) - (a - 1.0) * cw + beta, 2.0 * ((a - 1.0) - (a + 1.0) * cw), (a + 1.0) - (a - 1.0) * cw - beta);
+}
+
+BiquadCascade::Coefficients BiquadCascade::highPass(std::uint32_t sampleRate, float frequency, float q) {
+  const double w = 2.0 * M_PI * frequency / sampleRate;
+  const double cw = cos(w);
+  const double alpha = sin(w) / (2.0 * q);
+  return normalize((1.0 + cw) / 2.0, -(1.0 + cw), (1.0 + cw) / 2.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+}
+
+BiquadCascade::Coefficients BiquadCascade::lowPass(std::uint32_t sampleRate, float frequency, float q) {
+  const double w = 2.0 * M_PI * frequency / sampleRate;
+  const double cw = cos(w);
+  const double alpha = sin(w) / (2.0 * q);
+  return normalize((1.0 - cw) / 2.0, 1.0 - cw, (1.0 - cw) / 2.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+}
@@ -9,7 +9,10 @@ DummyAudio::DummyAudio(std::uint16_t sampleRate, std::uint8_t bitDepth, std::uin
   super(sampleRate, bitDepth, bitDepth, bufferMsec, channelNum) {
 }
 void DummyAudio::begin() {}
-void DummyAudio::start() {}
+void DummyAudio::start() {
+  playedFrames = 0;
+  capturedFrames = 0;
+}
 void DummyAudio::stop() {}
 void DummyAudio::zero() {}
 int DummyAudio::availableForWrite() {
@@ -19,8 +22,16 @@ int DummyAudio::available() {
   return getPayloadSize();
 }
 std::size_t DummyAudio::read(std::uint8_t *buffer, std::size_t length) {
+  capturedFrames += length * getBufferLength() / getPayloadSize();
   return length;
 }
 std::size_t DummyAudio::write(const uint8_t *buffer, std::size_t length) {
+  playedFrames += length * getBufferLength() / getPayloadSize();
   return length;
+}
+std::uint64_t DummyAudio::getPlayedFrames() const {
+  return playedFrames;
+}
+std::uint64_t DummyAudio::getCapturedFrames() const {
+  return capturedFrames;
 }
\ No newline at end of file
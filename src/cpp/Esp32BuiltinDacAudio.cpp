@@ -40,76 +40,263 @@ Esp32BuiltinDacAudio::Esp32BuiltinDacAudio(std::uint16_t sampleRate, std::uint8_
       .chFormat = I2S_CHANNEL_FMT_RIGHT_LEFT,
       .comFormat = builtin_dac_comm_format,
       .txDescAutoClear = dcCutOffFrequency == 0,
-      .pinConfig = config.pinConfig
+      .pinConfig = config.pinConfig,
+      .packed24Storage = false
     }, ringBufferCount), dac_mode(dac_mode), dcCutOffFrequency(dcCutOffFrequency) {
 }
 
 Esp32BuiltinDacAudio::~Esp32BuiltinDacAudio() {
   Esp32BuiltinDacAudio::stop();  // virtualではなく、自分を呼ぶ
+  waitForTransition((std::uint32_t)getBufferMsec() * getBufferCount() * 4);  // 終わらなければ I2SAudio が止める
+  delete[] silenceTxPayload;
 }
 
 void Esp32BuiltinDacAudio::begin() {
   super::begin();
+  buildSilenceTxPayload();
+}
+
+void Esp32BuiltinDacAudio::buildSilenceTxPayload() {
+  // ミュート中に毎回変換しなくて済むよう、中立レベル(0)を変換済みの payload を持っておく。
+  // reserveFormat() の最大の長さで作るので、reconfigure() で周期が伸びても確保し直さない
+  if (!silenceTxPayload) {
+    silenceTxPayloadSize = getReservedStorageSize();
+    silenceTxPayload = new std::uint8_t[silenceTxPayloadSize];
+  }
+  uint16_t *t = reinterpret_cast<uint16_t*>(silenceTxPayload);
+  const uint16_t us = 0x8000U;
+  for (size_t i = 0; i < silenceTxPayloadSize / (CH_NUM * sizeof(uint16_t)); i++) {
+    t[i * CH_NUM + channelIndexRL] = (dac_mode&I2S_DAC_CHANNEL_RIGHT_EN)?us:0;
+    t[i * CH_NUM + (1-channelIndexRL)] = (dac_mode&I2S_DAC_CHANNEL_LEFT_EN)?us:0;
+  }
+}
+
+void Esp32BuiltinDacAudio::onFormatChanged() {
+  super::onFormatChanged();
+  dcBlockPrevInput = 0.0f;  // DC カットの係数は write() で getSampRate() から求め直す
+  dcBlockPrevOutput = 0.0f;
+  if (!isSuspended() && (dacStatus == DacStarting || dacStatus == DacRunning)) {
+    // onTxDmaCleared() で DMA は中立になっているので、ランプし直さずにそのまま再生を続ける
+    suspending = false;
+    if (dacStatus == DacStarting) {
+      setDacStatus(DacRunning);
+    }
+  } else {
+    rewindTransition();  // DMA はゼロクリアされて 0V になっている
+  }
+  onTxDrain();
+}
+
+void Esp32BuiltinDacAudio::onTxDmaCleared() {
+  super::onTxDmaCleared();
+  if (dacStatus != DacStarting && dacStatus != DacRunning) {
+    return;  // 停止のランプ中は 0V のままでよい
+  }
+  // ポートは止まっているので、DMA が満杯になったところで書けなくなって抜ける
+  while (writeTxDmaBuffer(silenceTxPayload, super::getPayloadSize())) {
+  }
 }
 
 //  start DAC
 //  DAC_Start()後は、DMAバッファが空になる前にDAC_Write()で出力データを書き込むこと
 void Esp32BuiltinDacAudio::start() {
+  if (dacStatus == DacStopping) {
+    // まだ I2S は動いているので、止めずに今のレベルから折り返す (0V まで積み終えていれば 0V から)
+    rampSlot = rampSlot < rampSlots ? rampSlots - rampSlot : 0;
+    dacStatus = DacStarting;
+    onTxDrain();
+    return;
+  }
+  super::start(); // 中でzeroとonStartedが呼ばれる
+}
+
+void Esp32BuiltinDacAudio::onStarted() {
+  super::onStarted();
   dcBlockPrevInput = 0.0f;
   dcBlockPrevOutput = 0.0f;
-  super::start(); // 中でzeroが呼ばれる
   // i2s_set_dac_mode(dac_mode);
-  dacStatus = DacStarting;
-  zero();  // DACの出力を0から中立にする
-  dacStatus = DacRunning;
-  zero();  // DACの出力を中立にする
+  dacStatus = DacStarting;  // DACの出力を0から中立にする
+  rampSlots = getBufferCount();
+  rampSlot = 0;
+  onTxDrain();
+  flush();  // 積んだランプをすぐ DMA へ送る
 }
 
 //  stop DAC
 //  データ出力後、DMAバッファが空になる前にこの関数を呼び出すこと
 void Esp32BuiltinDacAudio::stop() {
-  dacStatus = DacStopping;
-  zero();  // DACの出力を中立から0にする
-  dacStatus = DacStopped;
-  zero();  // DACの出力を0にする
-  super::stop();
+  if (isSuspended()) {
+    super::stop();  // 一時停止中はもう 0V なので、ランプなしで止める
+    if (dacStatus != DacStopped) {
+      setDacStatus(DacStopped);
+    }
+    return;
+  }
+  switch (dacStatus) {
+  case DacStopped: {
+    super::stop();
+    return;
+  }
+  case DacStopping: {
+    return;
+  }
+  case DacStarting: {
+    rampSlot = rampSlots - std::min<std::uint8_t>(rampSlot, rampSlots);  // 今のレベルから折り返す
+  } break;
+  case DacRunning: {
+    if (!suspending) {
+      rampSlots = getBufferCount();
+      rampSlot = 0;
+    }
+    suspending = false;  // 一時停止前のランプ中なら、同じランプのまま止める
+  } break;
+  }
+  dacStatus = DacStopping;  // DACの出力を中立から0にする
+  onTxDrain();
 }
 
 void Esp32BuiltinDacAudio::zero() {
+  super::zero();  // リングと DMA を捨てる。DMA の 0 は DAC の 0V
+  rewindTransition();
+}
+
+void Esp32BuiltinDacAudio::rewindTransition() {
+  suspending = false;
+  if (isSuspended()) {
+    return;  // 0V で止めてあり、再開時にランプする
+  }
+  switch (dacStatus) {
+  case DacStarting:
+  case DacRunning: {
+    dacStatus = DacStarting;
+    rampSlots = getBufferCount();
+    rampSlot = 0;
+  } break;
+  case DacStopping: {
+    rampSlot = getStopSlots();  // もう 0V なので、送出し終えるのを待つだけ
+  } break;
+  case DacStopped: { } break;
+  }
+}
+
+std::uint8_t Esp32BuiltinDacAudio::getStopSlots() const {
+  // auto clear なしでは DMA が最後のデータを繰り返すので、ランプの後に DMA 全体を 0V で埋める
+  return dcCutOffFrequency == 0 ? rampSlots : rampSlots + getBufferCount();
+}
+
+void Esp32BuiltinDacAudio::buildLevelTxPayload(std::uint8_t* payload, std::uint8_t slot) const {
   const int32_t bottom = INT16_MIN;  // DACの0V
-  uint8_t tmp[getPayloadSize()];
-  int16_t *t = reinterpret_cast<int16_t*>(tmp);
-  switch (dacStatus)
-  {
+  const int32_t total = (int32_t)(rampSlots * getBufferLength());
+  uint16_t *t = reinterpret_cast<uint16_t*>(payload);
+  for (size_t i = 0; i < getBufferLength(); i++) {
+    const int32_t position = (int32_t)(slot * getBufferLength() + i);
+    int32_t v = bottom;
+    if (dacStatus == DacStarting) {
+      v = bottom - bottom * position / total;
+    } else if (position < total) {
+      v = bottom * position / total;
+    }
+    const uint16_t us = ((uint16_t)(int16_t)v)^0x8000U;  // XOR (signed -> unsigned)
+    t[i * CH_NUM + channelIndexRL] = (dac_mode&I2S_DAC_CHANNEL_RIGHT_EN)?us:0;
+    t[i * CH_NUM + (1-channelIndexRL)] = (dac_mode&I2S_DAC_CHANNEL_LEFT_EN)?us:0;
+  }
+}
+
+void Esp32BuiltinDacAudio::onTxDrain() {
+  super::onTxDrain();
+  if (!isTransitioning() && !suspending) {
+    return;
+  }
+  uint8_t tmp[super::getPayloadSize()];
+  if (suspending) {
+    // 一時停止前のランプ。dacStatus は DacRunning のままなので中立から 0V へ下がる
+    while (rampSlot < getStopSlots()) {
+      buildLevelTxPayload(tmp, rampSlot);
+      if (!pushTxSlot(tmp)) {
+        return;
+      }
+      rampSlot++;
+    }
+    if (getOutputLatencyFrames() == 0) {
+      suspending = false;
+      suspend();  // 0V まで送出し終えてから I2S を止める
+    }
+    return;
+  }
+  switch (dacStatus) {
   case DacStarting: {
-    for(size_t j = 0; j < getBufferCount(); j++) {
-      for(size_t i = 0; i < getBufferLength(); i++) {
-        const int16_t v = bottom-(bottom*(int32_t)(j*getBufferLength()+i)/(int32_t)(getBufferCount()*getBufferLength()));
-        t[i] = v;
+    while (rampSlot < rampSlots) {
+      buildLevelTxPayload(tmp, rampSlot);
+      if (!pushTxSlot(tmp)) {
+        return;  // 続きはリングが空いてから
       }
-      waitForWritable();
-      write(reinterpret_cast<const uint8_t*>(tmp), getPayloadSize());
+      rampSlot++;
     }
-  } break;
-  case DacRunning: {
-    fill(0);
+    setDacStatus(DacRunning);
   } break;
   case DacStopping: {
-    for(size_t j = 0; j < getBufferCount(); j++) {
-      for(size_t i = 0; i < getBufferLength(); i++) {
-        const int16_t v = bottom*(1-(j*getBufferLength()+i)/(getBufferCount()*getBufferLength()));
-        t[i] = v;
+    while (rampSlot < getStopSlots()) {
+      buildLevelTxPayload(tmp, rampSlot);
+      if (!pushTxSlot(tmp)) {
+        return;
       }
-      waitForWritable();
-      write(reinterpret_cast<const uint8_t*>(tmp), getPayloadSize());
+      rampSlot++;
+    }
+    if (getOutputLatencyFrames() == 0) {
+      super::stop();
+      setDacStatus(DacStopped);
     }
   } break;
-  case DacStopped: {
-    fill(bottom);
-  } break;
+  default: { } break;
   }
 }
 
+void Esp32BuiltinDacAudio::setDacStatus(DacStatus status) {
+  dacStatus = status;
+  if (statusCallback) {
+    statusCallback(status, statusCallbackArg);
+  }
+}
+
+bool Esp32BuiltinDacAudio::canSuspend() {
+  if (dacStatus == DacRunning && !suspending) {
+    // すぐには止めず、中立から 0V へのランプを積む。送出し終えたところで onTxDrain() が止める
+    suspending = true;
+    rampSlots = 1;
+    rampSlot = 0;
+    onTxDrain();
+  }
+  return false;
+}
+
+bool Esp32BuiltinDacAudio::isTransitioning() const {
+  return dacStatus == DacStarting || dacStatus == DacStopping;
+}
+
+void Esp32BuiltinDacAudio::setStatusCallback(DacStatusCallback callback, void* arg) {
+  statusCallback = callback;
+  statusCallbackArg = arg;
+}
+
+bool Esp32BuiltinDacAudio::waitForTransition(std::uint32_t maxWaitMsec) {
+  const std::uint32_t startMsec = millis();
+  while (isTransitioning()) {
+    if (maxWaitMsec <= millis() - startMsec) {
+      return false;
+    }
+    super::availableForWrite();  // DMA イベントを処理して遷移を進める
+    delay(1);
+  }
+  return true;
+}
+
+bool Esp32BuiltinDacAudio::waitForWritable(std::uint32_t maxWaitMsec) {
+  if (isTransitioning() && !waitForTransition(maxWaitMsec)) {
+    return false;
+  }
+  return super::waitForWritable(maxWaitMsec);
+}
+
 bool Esp32BuiltinDacAudio::handleTxIdle() {
   if (dcCutOffFrequency == 0 || dacStatus != DacRunning) {
     return false;
@@ -120,17 +307,42 @@ bool Esp32BuiltinDacAudio::handleTxIdle() {
 }
 
 void Esp32BuiltinDacAudio::fill(int16_t v) {
-  uint8_t tmp[getPayloadSize()];
-  int16_t *t = reinterpret_cast<int16_t*>(tmp);
+  uint8_t tmp[super::getPayloadSize()];
+  uint16_t *t = reinterpret_cast<uint16_t*>(tmp);
+  const uint16_t us = ((uint16_t)v)^0x8000U;  // XOR (signed -> unsigned)
+  for (size_t i = 0; i < getBufferLength(); i++) {
+    t[i * CH_NUM + channelIndexRL] = (dac_mode&I2S_DAC_CHANNEL_RIGHT_EN)?us:0;
+    t[i * CH_NUM + (1-channelIndexRL)] = (dac_mode&I2S_DAC_CHANNEL_LEFT_EN)?us:0;
+  }
   for(size_t j = 0; j < getBufferCount(); j++) {
-    for(size_t i = 0; i < getBufferLength(); i++) {
-      t[i] = v;
+    if (!pushTxSlot(tmp)) {
+      break;
     }
-    waitForWritable();
-    write(reinterpret_cast<const uint8_t*>(tmp), getPayloadSize());
   }
 }
 
+void Esp32BuiltinDacAudio::setVolume(std::uint16_t volume, std::uint16_t rampMsec, AudioGain::RampMode mode) {
+  gain.setRampMode(mode);
+  gain.setTarget(volume, (std::uint32_t)getSampRate() * rampMsec / 1000);
+}
+
+void Esp32BuiltinDacAudio::setMute(bool mute, std::uint16_t rampMsec) {
+  gain.setMute(mute, (std::uint32_t)getSampRate() * rampMsec / 1000);
+}
+
+void Esp32BuiltinDacAudio::renderTxSlot() {
+  if (dacStatus != DacRunning) {
+    return;  // ランプ中はソースを読み進めない
+  }
+  uint8_t tmp[getPayloadSize()];
+  renderCallback(tmp, getBufferLength(), renderCallbackArg);
+  write(tmp, getPayloadSize());
+}
+
+void Esp32BuiltinDacAudio::setTxActivityDetector(AudioActivityDetector* detector) {
+  txActivityDetector = detector;
+}
+
 std::size_t const Esp32BuiltinDacAudio::getPayloadSize() const {
   return super::getPayloadSize() / CH_NUM;
 }
@@ -141,19 +353,41 @@ size_t Esp32BuiltinDacAudio::read(std::uint8_t *buffer, std::size_t length) {
 
 size_t Esp32BuiltinDacAudio::write(const std::uint8_t *buffer, std::size_t length) {
   // length==getPayloadSize()
+  if (dacStatus == DacRunning && (suspending || resume())) {
+    // 一時停止中と一時停止前のランプ中は 0V 側にいるので、1 周期で中立へ戻してから書く
+    // (ランプをまだ積めていなければ中立のままなので、戻すランプも要らない)
+    rampSlot = suspending && rampSlot == 0 ? 1 : 0;
+    rampSlots = 1;
+    suspending = false;
+    dacStatus = DacStarting;
+    onTxDrain();
+  }
   uint8_t tmp[super::getPayloadSize()];
   if (length <= available()) {
     super::read(reinterpret_cast<uint8_t*>(tmp), super::getPayloadSize());
   }
   if (length <= availableForWrite()) {
+    // 開始/停止のランプは onTxDrain() が積むので、ここに来るのは再生中の信号だけ
+    const bool silent = silenceTxPayload && (gain.isSilent() ||
+      (txActivityDetector && !txActivityDetector->update(AudioBlock<const int16_t>(reinterpret_cast<const int16_t*>(buffer), getBufferLength(), 1))));
+    if (silent) {
+      // ミュート確定後/無音周期は変換せず、キャッシュ済みの無音を送る
+      dcBlockPrevInput = 0.0f;
+      dcBlockPrevOutput = 0.0f;
+      return super::write(silenceTxPayload, super::getPayloadSize()) / CH_NUM;
+    }
     const int16_t *b = reinterpret_cast<const int16_t*>(buffer);
     uint16_t *t = reinterpret_cast<uint16_t*>(tmp);
+    const bool unity = gain.isUnity();
+    const float rc = (dcCutOffFrequency > 0) ? 1.0f / (2.0f * (float)M_PI * dcCutOffFrequency) : 0.0f;
+    const float dt = 1.0f / getSampRate();
+    const float alpha = rc / (rc + dt);
     for (size_t i = 0; i < getBufferLength(); i++) {
       int16_t s = b[i];
+      if (!unity) {
+        s = AudioGain::apply(s, gain.next());
+      }
       if (dcCutOffFrequency > 0) {
-        const float rc = 1.0f / (2.0f * (float)M_PI * dcCutOffFrequency);
-        const float dt = 1.0f / getSampRate();
-        const float alpha = rc / (rc + dt);
         const float input = (float)s;
         const float filtered = alpha * (dcBlockPrevOutput + input - dcBlockPrevInput);
         dcBlockPrevInput = input;
@@ -171,7 +405,8 @@ size_t Esp32BuiltinDacAudio::write(const std::uint8_t *buffer, std::size_t lengt
 }
 
 int Esp32BuiltinDacAudio::availableForWrite() {
-  return super::availableForWrite() / CH_NUM;
+  const int length = super::availableForWrite() / CH_NUM;  // 遷移中も DMA イベントは処理する
+  return dacStatus == DacRunning ? length : 0;
 }
 
 int Esp32BuiltinDacAudio::available() {
@@ -0,0 +1,104 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../FilteredAudio.h"
+#include <string.h>
+
+FilteredAudio::FilteredAudio(Audio* output, BiquadCascade* filter) :
+  super(output), output(output), filter(filter) {
+}
+
+void FilteredAudio::begin() {
+  output->begin();
+}
+
+void FilteredAudio::start() {
+  filter->reset();
+  output->start();
+}
+
+void FilteredAudio::stop() {
+  output->stop();
+}
+
+void FilteredAudio::zero() {
+  output->zero();
+}
+
+void FilteredAudio::flush() {
+  output->flush();
+}
+
+int FilteredAudio::available() {
+  return output->available();
+}
+
+int FilteredAudio::availableForWrite() {
+  return output->availableForWrite();
+}
+
+bool FilteredAudio::waitForWritable(std::uint32_t maxWaitMsec) {
+  return output->waitForWritable(maxWaitMsec);
+}
+
+bool FilteredAudio::waitForReadable(std::uint32_t maxWaitMsec) {
+  return output->waitForReadable(maxWaitMsec);
+}
+
+std::size_t FilteredAudio::read(std::uint8_t *buffer, std::size_t length) {
+  return output->read(buffer, length);
+}
+
+std::size_t FilteredAudio::readTimestamped(std::uint8_t *buffer, std::size_t length, std::uint64_t *frameIndex) {
+  return output->readTimestamped(buffer, length, frameIndex);
+}
+
+std::size_t FilteredAudio::write(const std::uint8_t *buffer, std::size_t length) {
+  if (output->getSampRate() != getSampRate() || output->getBufferMsec() != getBufferMsec()) {
+    setFormat(output->getSampRate(), output->getBufferMsec());  // 出力先の reconfigure() に追従する
+    filter->reset();
+  }
+  if (filter->getSectionCount() == 0) {
+    return output->write(buffer, length);
+  }
+  if (filter->getSampRate() != getSampRate()) {
+    return 0;  // 係数が旧サンプリング周波数のまま
+  }
+  if (length != getPayloadSize() || output->availableForWrite() < (int)length) {
+    return 0;
+  }
+  std::uint8_t tmp[length];
+  memcpy(tmp, buffer, length);
+  switch (getAlignedBitLength()) {
+    case 16: {
+      filter->process(makeBlock(reinterpret_cast<std::int16_t*>(tmp)));
+    } break;
+    case 32: {
+      filter->process(makeBlock(reinterpret_cast<std::int32_t*>(tmp)));
+    } break;
+    default: { } break;  // 24bit 詰めなどはそのまま通す
+  }
+  return output->write(tmp, length);
+}
+
+std::uint8_t FilteredAudio::getBufferCount() const {
+  return output->getBufferCount();
+}
+
+std::uint64_t FilteredAudio::getPlayedFrames() const {
+  return output->getPlayedFrames();
+}
+
+std::uint64_t FilteredAudio::getCapturedFrames() const {
+  return output->getCapturedFrames();
+}
+
+std::uint32_t FilteredAudio::getOutputLatencyFrames() const {
+  return output->getOutputLatencyFrames();
+}
+
+std::uint32_t FilteredAudio::getUnderrunCount() const {
+  return output->getUnderrunCount();
+}
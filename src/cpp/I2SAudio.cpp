@@ -4,7 +4,9 @@
  */
 
 #include "../I2SAudio.h"
+#include "../AudioPack24.h"
 #include <driver/rtc_io.h>
+#include <algorithm>
 #include <string.h>
 
 #define ARDUINO_AUDIO_SPIRAM_ENABLED
@@ -47,22 +49,59 @@ I2SAudio::I2SAudio(std::uint16_t sampleRate, std::uint8_t bitDepth, std::uint8_t
         // .use_apll = false
       }),
       ringBufferCount(ringBufferCount ? ringBufferCount : bufferCount),
-      status(I2SAudioStop) {
+      packed24(audioConfig.packed24Storage && bitDepth == 24 && alignedBitLength == 32),
+      status(I2SAudioStop), clockSampleRate(0), clockBitsCfg(0), clockChannel(I2S_CHANNEL_STEREO), pinConfigured(false) {
   ringTxBuffer   = nullptr;
+  slotSize       = getStorageSize();
+  ringTxReadOffset = 0;
+  rxReadOffset   = 0;
+  staticBuffers  = false;
   ringTxReadIdx  = 0;
   ringTxWriteIdx = 0;
   ringTxCount    = 0;
   txPrimed       = false;
   handlingTxIdle = false;
   txIdleFilled   = false;
+  idleSuspendPeriods = 0;
+  txIdlePeriods  = 0;
+  suspendCount   = 0;
+  lastResumeMicros = 0;
+  resumeStartMicros = 0;
+  resumePending  = false;
+  maxResumeMicros = 0;
+  dispatchingCallbacks = false;
+  lastEventMsec  = 0;
+  playedFrames   = 0;
+  capturedFrames = 0;
+  dmaPendingFrames = 0;
+  txUnderruns    = 0;
+  txDataStarted  = false;
+  i2s_event_queue = nullptr;
+  rxPendingFrames = 0;
+  rxFrameIndex   = 0;
+  captureAnalyzer = nullptr;
+  captureActivityDetector = nullptr;
+  captureSilent = false;
+  pack24Scratch = nullptr;
   rxBuffer = nullptr;  // virtualではなく、自分を呼ぶ。begin()でPSRAM初期化後に確保する
   initRtcPin(audioConfig.pinConfig.bck_io_num);
   initRtcPin(audioConfig.pinConfig.ws_io_num);
   initRtcPin(audioConfig.pinConfig.data_out_num);
+  if (audioConfig.packed24Storage && !packed24) {
+    log_w("I2SAudio: packed24Storage needs bitDepth 24 and alignedBitLength 32");
+  }
 }
 
 I2SAudio::~I2SAudio() {
   I2SAudio::stop();  // virtualではなく、自分を呼ぶ
+  if (i2s_event_queue) {
+    // 同じポートで作り直せるようにドライバを解放する
+    i2s_driver_uninstall(audioConfig.port);
+    i2s_event_queue = nullptr;
+  }
+  if (staticBuffers) {
+    return;
+  }
 #ifdef ARDUINO_AUDIO_SPIRAM_ENABLED
   heap_caps_free(ringTxBuffer);
   heap_caps_free(rxBuffer);
@@ -70,6 +109,31 @@ I2SAudio::~I2SAudio() {
   delete[] ringTxBuffer;
   delete[] rxBuffer;
 #endif
+  delete[] pack24Scratch;
+}
+
+void I2SAudio::useStaticBuffers(char* ring, char* rx, std::int32_t* scratch) {
+  ringTxBuffer = ring;
+  rxBuffer = rx;
+  pack24Scratch = scratch;
+  slotSize = getStorageSize();
+  staticBuffers = true;
+}
+
+void I2SAudio::reserveFormat(std::uint16_t maxSampleRate, std::uint16_t maxBufferMsec) {
+  if (ringTxBuffer) {
+    log_e("I2SAudio: reserveFormat() must be called before begin()");
+    return;
+  }
+  const std::size_t frames = ((std::uint32_t)maxSampleRate * maxBufferMsec) / 1000;
+  const std::size_t payload = (getChannelNum() * frames) * ((getAlignedBitLength() + 7) / 8);
+  const std::size_t size = packed24 ? AudioPack24::packedSize(payload) : payload;
+  slotSize = std::max(size, getStorageSize());
+}
+
+std::uint16_t I2SAudio::getDmaMsec() const {
+  const std::uint32_t msec = (std::uint32_t)i2sConfig.dma_buf_len * 1000 / i2sConfig.sample_rate;
+  return msec ? msec : 1;
 }
 
 std::uint8_t I2SAudio::getBufferCount() const {
@@ -80,9 +144,28 @@ std::uint8_t I2SAudio::getRingBufferCount() const {
   return ringBufferCount;
 }
 
+std::size_t I2SAudio::getStorageSize() const {
+  return packed24 ? AudioPack24::packedSize(I2SAudio::getPayloadSize()) : I2SAudio::getPayloadSize();
+}
+
+std::size_t I2SAudio::getReservedStorageSize() const {
+  return slotSize;
+}
+
+bool I2SAudio::isPacked24Storage() const {
+  return packed24;
+}
+
 void I2SAudio::begin() {
+  if (!staticBuffers) {
+    allocateBuffers();
+  }
+  ESP_ERROR_CHECK(i2s_driver_install(audioConfig.port, &i2sConfig, getBufferCount()*2, &i2s_event_queue));
+}
+
+void I2SAudio::allocateBuffers() {
   // PSRAM 初期化後に呼ばれるため、ここで SPIRAM 優先確保する
-  const std::size_t ringSize = getRingBufferCount() * I2SAudio::getPayloadSize();
+  const std::size_t ringSize = getRingBufferCount() * slotSize;
 #ifdef ARDUINO_AUDIO_SPIRAM_ENABLED
   ringTxBuffer = (char*)heap_caps_malloc(ringSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
 #endif
@@ -90,7 +173,7 @@ void I2SAudio::begin() {
     log_e("I2SAudio: SPIRAM unavailable, fallback to internal RAM for ring buffer");
     ringTxBuffer = new char[ringSize];
   }
-  const std::size_t rxSize = I2SAudio::getPayloadSize();  // virtualではなく、自分を呼ぶ
+  const std::size_t rxSize = slotSize;
 #ifdef ARDUINO_AUDIO_SPIRAM_ENABLED
   rxBuffer = (char*)heap_caps_malloc(rxSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
 #endif
@@ -98,11 +181,17 @@ void I2SAudio::begin() {
     log_e("I2SAudio: SPIRAM unavailable, fallback to internal RAM for rx buffer");
     rxBuffer = new char[rxSize];
   }
-  ESP_ERROR_CHECK(i2s_driver_install(audioConfig.port, &i2sConfig, getBufferCount()*2, &i2s_event_queue));
+  if (packed24) {
+    pack24Scratch = new std::int32_t[slotSize / 3];  // コールバック経路で毎周期触るので内部 RAM に置く
+  }
 }
 
 void I2SAudio::start() {
   _start(I2SAudioStart);
+  onStarted();
+}
+
+void I2SAudio::onStarted() {
   if (((uint8_t)i2sConfig.mode & (uint8_t)I2S_MODE_RX) == (uint8_t)I2S_MODE_RX) {
     rxFilled = getBufferCount();
   }
@@ -111,39 +200,108 @@ void I2SAudio::start() {
 //  start DAC
 //  DAC_Start()後は、DMAバッファが空になる前にDAC_Write()で出力データを書き込むこと
 void I2SAudio::_start(I2SAudioStatus s) {
+  _prepareStart();
+  ESP_ERROR_CHECK(i2s_start(audioConfig.port));
+  _finishStart(s);
+}
+
+void I2SAudio::_prepareStart() {
   I2SAudio::stop();  // virtualではなく、自分を呼ぶ
   deinitRtcPin(audioConfig.pinConfig.bck_io_num);
   deinitRtcPin(audioConfig.pinConfig.ws_io_num);
   deinitRtcPin(audioConfig.pinConfig.data_out_num);
-
-  const bool hasPinConfig = 0<=audioConfig.pinConfig.bck_io_num ||
+  // stop() で RTC GPIO に戻したピンは I2S へつなぎ直す。戻すピンが無ければ (内蔵 DAC など) 最初の 1 回だけでよい
+  const bool hasRtcPin = 0<=audioConfig.pinConfig.bck_io_num ||
                       0<=audioConfig.pinConfig.ws_io_num ||
-                      0<=audioConfig.pinConfig.data_out_num ||
-                      0<=audioConfig.pinConfig.data_in_num;
+                      0<=audioConfig.pinConfig.data_out_num;
+  if (!pinConfigured || hasRtcPin) {
+    const bool hasPinConfig = hasRtcPin || 0<=audioConfig.pinConfig.data_in_num;
+    i2s_set_pin(audioConfig.port, hasPinConfig?&(audioConfig.pinConfig):NULL);
+    pinConfigured = true;
+  }
+  _setClock();
+  zero();  // i2s_start() 前に DMA を空にしておく
+}
+
+void I2SAudio::_setClock() {
 #if defined(IDF_VER)
   const uint32_t bits_cfg = ((uint32_t)I2S_BITS_PER_CHAN_32BIT << 16) | (uint32_t)i2sConfig.bits_per_sample;
 #else
   const uint32_t bits_cfg = (uint32_t)i2sConfig.bits_per_sample;
 #endif
-  i2s_set_pin(audioConfig.port, hasPinConfig?&(audioConfig.pinConfig):NULL);
   i2s_channel_t clock_channel = I2S_CHANNEL_STEREO;
   switch (i2sConfig.channel_format) {
     case I2S_CHANNEL_FMT_RIGHT_LEFT:
     case I2S_CHANNEL_FMT_ALL_RIGHT:
     case I2S_CHANNEL_FMT_ALL_LEFT: {
       clock_channel = I2S_CHANNEL_STEREO;
-      i2s_set_clk(audioConfig.port, i2sConfig.sample_rate, bits_cfg, clock_channel);
     } break;
     case I2S_CHANNEL_FMT_ONLY_RIGHT:
     case I2S_CHANNEL_FMT_ONLY_LEFT: {
       clock_channel = I2S_CHANNEL_MONO;
-      i2s_set_clk(audioConfig.port, i2sConfig.sample_rate, bits_cfg, clock_channel);
+    } break;
+    default: {
+      return;
     } break;
   }
-  ESP_ERROR_CHECK(i2s_start(audioConfig.port));
+  if (clockSampleRate == (std::uint32_t)i2sConfig.sample_rate && clockBitsCfg == bits_cfg && clockChannel == clock_channel) {
+    return;  // 2 回目以降の start() ではクロックを計算し直さない
+  }
+  i2s_set_clk(audioConfig.port, i2sConfig.sample_rate, bits_cfg, clock_channel);
+  clockSampleRate = i2sConfig.sample_rate;
+  clockBitsCfg = bits_cfg;
+  clockChannel = clock_channel;
+}
+
+bool I2SAudio::reconfigure(std::uint16_t sampleRate, std::uint16_t bufferMsec) {
+  const std::size_t frames = ((std::uint32_t)sampleRate * bufferMsec) / 1000;
+  const std::size_t payload = (getChannelNum() * frames) * ((getAlignedBitLength() + 7) / 8);
+  if (!i2s_event_queue || frames == 0 || slotSize < (packed24 ? AudioPack24::packedSize(payload) : payload)) {
+    log_e("I2SAudio: cannot reconfigure to %u Hz / %u msec", sampleRate, bufferMsec);
+    return false;
+  }
+  const I2SAudioStatus s = status;
+  const bool running = s == I2SAudioStart || s == I2SAudioOscillation;  // 一時停止中は止めたまま
+  if (running) {
+    i2s_stop(audioConfig.port);
+  }
+  setFormat(sampleRate, bufferMsec);
+  i2sConfig.sample_rate = sampleRate;
+  if (running) {
+    _setClock();  // i2s_set_clk() はポートを動かすので、止まっているときは次の start()/resume() まで遅らせる
+  }
+  I2SAudio::zero();  // 旧フォーマットのデータを捨てる。virtualではなく、自分を呼ぶ
+  if (running) {
+    _finishStart(s);  // onTxDmaCleared() で DMA に詰めたフレームを数えるため、i2s_start() より前に初期化する
+    onTxDmaCleared();
+    ESP_ERROR_CHECK(i2s_start(audioConfig.port));
+    if (((uint8_t)i2sConfig.mode & (uint8_t)I2S_MODE_RX) == (uint8_t)I2S_MODE_RX) {
+      rxFilled = getBufferCount();
+    }
+  }
+  onFormatChanged();
+  return true;
+}
+
+void I2SAudio::onFormatChanged() {
+}
+
+void I2SAudio::onTxDmaCleared() {
+}
+
+void I2SAudio::_finishStart(I2SAudioStatus s) {
+  playedFrames = 0;
+  capturedFrames = 0;
+  dmaPendingFrames = 0;
+  txUnderruns = 0;
+  txDataStarted = false;
+  resumePending = false;
+  rxPendingFrames = 0;
+  rxFrameIndex = 0;
   rxDone = false;
   rxFilled = 0;
-  zero();
+  rxReadOffset = 0;
+  lastEventMsec = millis();
   status = s;
 }
 
@@ -165,10 +323,65 @@ void I2SAudio::zero() {
   ringTxCount    = 0;
   ringTxReadIdx  = 0;
   ringTxWriteIdx = 0;
+  ringTxReadOffset = 0;
   txPrimed       = false;
   txIdleFilled   = false;
 }
 
+void I2SAudio::onTxDrain() {
+}
+
+bool I2SAudio::canSuspend() {
+  return true;
+}
+
+void I2SAudio::setIdleSuspend(std::uint16_t idlePeriods) {
+  idleSuspendPeriods = idlePeriods;
+  txIdlePeriods = 0;
+}
+
+bool I2SAudio::isSuspended() const {
+  return status == I2SAudioSuspend;
+}
+
+std::uint32_t I2SAudio::getSuspendCount() const {
+  return suspendCount;
+}
+
+std::uint32_t I2SAudio::getLastResumeMicros() const {
+  return lastResumeMicros;
+}
+
+std::uint32_t I2SAudio::getMaxResumeMicros() const {
+  return maxResumeMicros;
+}
+
+void I2SAudio::suspend() {
+  // ピンは RTC に戻さず、次の再開で i2s_start() だけすればよい状態で止める
+  i2s_stop(audioConfig.port);
+  i2s_zero_dma_buffer(audioConfig.port);  // 再開直後に古いデータを出さない。内蔵 DAC では 0V
+  dmaPendingFrames = 0;
+  txIdleFilled = false;
+  txIdlePeriods = 0;
+  suspendCount++;
+  status = I2SAudioSuspend;
+}
+
+bool I2SAudio::resume() {
+  if (status != I2SAudioSuspend) {
+    return false;
+  }
+  resumeStartMicros = micros();
+  resumePending = true;  // 所要時間は再開後のデータが送出された TX_DONE で確定する
+  xQueueReset(i2s_event_queue);  // 停止直前のイベントを数えない
+  _setClock();  // 一時停止中の reconfigure() はクロックを変えていない
+  ESP_ERROR_CHECK(i2s_start(audioConfig.port));
+  txDataStarted = false;
+  lastEventMsec = millis();
+  status = I2SAudioStart;
+  return true;
+}
+
 bool I2SAudio::handleTxIdle() {
   return false;
 }
@@ -195,6 +408,7 @@ bool I2SAudio::writeTxDmaBuffer(const std::uint8_t* payload, std::size_t length,
     if (bytesWritten < length) {
       return false;
     }
+    dmaPendingFrames += getBufferLength();
   }
   return true;
 }
@@ -216,10 +430,29 @@ bool I2SAudio::_recvQueue(i2s_event_type_t type) {
     } break;
     case I2S_EVENT_TX_DONE: {
       // DMAバッファが1つ消費された。次のドレインをトリガーする。
+      const std::uint32_t dmaFrames = i2sConfig.dma_buf_len;
+      playedFrames += dmaFrames;
+      if (dmaPendingFrames == 0 && txDataStarted && status == I2SAudioStart) {
+        txUnderruns++;  // 書き込み済みデータが無いまま DMA 1 本分が送出された
+      }
+      if (resumePending && txDataStarted && 0 < dmaPendingFrames) {
+        // 再開後に書いたデータを載せた最初の DMA バッファが送出された
+        resumePending = false;
+        lastResumeMicros = micros() - resumeStartMicros;
+        maxResumeMicros = std::max(maxResumeMicros, lastResumeMicros);
+      }
+      // auto clear の無音送出でも TX_DONE は来るので 0 で止める
+      dmaPendingFrames = (dmaFrames < dmaPendingFrames) ? dmaPendingFrames - dmaFrames : 0;
+      if (ringTxCount == 0 && dmaPendingFrames == 0) {
+        txIdlePeriods++;  // 書いたデータを送出し終えてから数える
+      }
       return true;
     } break;
     case I2S_EVENT_RX_DONE: {
       // All buffers are full. This means we have an overflow.
+      capturedFrames += i2sConfig.dma_buf_len;
+      // 読み出しが追いつかないとドライバは古いバッファを上書きするので、DMA の本数分で頭打ち
+      rxPendingFrames = std::min<std::uint32_t>(rxPendingFrames + i2sConfig.dma_buf_len, (std::uint32_t)getBufferCount() * i2sConfig.dma_buf_len);
       rxFilled = getBufferCount();
       return true;
     } break;
@@ -229,8 +462,10 @@ bool I2SAudio::_recvQueue(i2s_event_type_t type) {
 }
 
 bool I2SAudio::_eventQueue(TickType_t ticks_to_wait) {
+  if (status == I2SAudioSuspend) {
+    return false;  // 止めているのでイベントは来ない
+  }
   const std::uint32_t startMsec = millis();
-  static std::uint32_t lastMsec = millis();
   i2s_event_t event;
   log_v("%d", uxQueueMessagesWaiting(i2s_event_queue));
 
@@ -238,37 +473,42 @@ bool I2SAudio::_eventQueue(TickType_t ticks_to_wait) {
   if(ringTxCount > 0 || rxFilled) {
     ticks_to_wait = 0;
   }
-  const std::uint32_t elapsedMsec = startMsec - lastMsec;
-  if (xQueueReceive(i2s_event_queue, &event, std::min((TickType_t)getBufferMsec()*getBufferCount(), ticks_to_wait)) == pdTRUE) {
+  const std::uint32_t elapsedMsec = startMsec - lastEventMsec;
+  if (xQueueReceive(i2s_event_queue, &event, std::min((TickType_t)getDmaMsec()*getBufferCount(), ticks_to_wait)) == pdTRUE) {
     bool done = false;
     done |= _recvQueue(event.type);
     while (xQueueReceive(i2s_event_queue, &event, 0) == pdTRUE) {
       done |= _recvQueue(event.type);
     }
-    if(done) lastMsec = millis();
-  } else if((std::uint32_t)getBufferMsec()*getBufferCount()<=elapsedMsec){
+    if(done) lastEventMsec = millis();
+  } else if((std::uint32_t)getDmaMsec()*getBufferCount()<=elapsedMsec){
     log_w("i2s: event timeout");
     if (((uint8_t)i2sConfig.mode & (uint8_t)I2S_MODE_RX) == (uint8_t)I2S_MODE_RX) {
       rxFilled = getBufferCount();
     }
-    lastMsec = millis();
+    lastEventMsec = millis();
   }
 
+  if (idleSuspendPeriods && idleSuspendPeriods <= txIdlePeriods && ringTxCount == 0 && dmaPendingFrames == 0 && status == I2SAudioStart &&
+      ((uint8_t)i2sConfig.mode & (uint8_t)I2S_MODE_RX) != (uint8_t)I2S_MODE_RX && canSuspend()) {
+    suspend();
+    return true;
+  }
+
+  onTxDrain();
+
   // TX: 一定量プリフィル後にリングバッファから DMA へドレイン
   while (txPrimed && ringTxCount > 0) {
-    std::size_t bytesWritten = 0;
-#ifdef I2S_LEGACY_API_ENABLED
-    int bw = i2s_write_bytes(audioConfig.port,
-      ringTxBuffer + ringTxReadIdx * I2SAudio::getPayloadSize(),
-      I2SAudio::getPayloadSize(), 0);
-    bytesWritten = (bw > 0) ? (std::size_t)bw : 0;
-#else
-    esp_err_t ret = i2s_write(audioConfig.port,
-      ringTxBuffer + ringTxReadIdx * I2SAudio::getPayloadSize(),
-      I2SAudio::getPayloadSize(), &bytesWritten, 0);
-    if (ret != ESP_OK) bytesWritten = 0;
-#endif
-    if (I2SAudio::getPayloadSize() <= bytesWritten) {
+    const std::size_t payload = I2SAudio::getPayloadSize();
+    const char* slot = ringTxBuffer + ringTxReadIdx * slotSize;
+    const std::size_t bytesWritten = packed24 ? _writePacked24Dma(slot, ringTxReadOffset, payload - ringTxReadOffset)
+                                              : _writeDma(slot + ringTxReadOffset, payload - ringTxReadOffset);
+    // 周期長と DMA バッファ長が違うと途中までしか書けないことがある。続きは次回
+    dmaPendingFrames += bytesWritten * getBufferLength() / payload;
+    ringTxReadOffset += bytesWritten;
+    if (payload <= ringTxReadOffset) {
+      ringTxReadOffset = 0;
+      txDataStarted = true;
       ringTxReadIdx = (ringTxReadIdx + 1) % getRingBufferCount();
       ringTxCount--;
       if (ringTxCount == 0) {
@@ -279,7 +519,7 @@ bool I2SAudio::_eventQueue(TickType_t ticks_to_wait) {
           handlingTxIdle = false;
         }
       }
-      lastMsec = millis();
+      lastEventMsec = millis();
     } else {
       break;  // DMA が満杯なので次回へ
     }
@@ -287,27 +527,200 @@ bool I2SAudio::_eventQueue(TickType_t ticks_to_wait) {
 
   // read
   if(rxFilled && !rxDone) {
-#ifdef I2S_LEGACY_API_ENABLED
-    int bytesRead = i2s_read_bytes(audioConfig.port, (char *)rxBuffer, I2SAudio::getPayloadSize(), ticks_to_wait);
-#else
-    std::size_t bytesRead = 0;
-    esp_err_t ret = i2s_read(audioConfig.port, reinterpret_cast<char *>(rxBuffer), I2SAudio::getPayloadSize(), &bytesRead, ticks_to_wait);
-    if (ret != ESP_OK) {
-      bytesRead = 0;
-    }
-#endif
-    if (I2SAudio::getPayloadSize() <= bytesRead) {
+    const std::size_t payload = I2SAudio::getPayloadSize();
+    const std::size_t bytesRead = packed24 ? _readPacked24Dma(rxReadOffset, payload - rxReadOffset, ticks_to_wait)
+                                           : _readDma(rxBuffer + rxReadOffset, payload - rxReadOffset, ticks_to_wait);
+    rxReadOffset += bytesRead;
+    const std::uint32_t readFrames = bytesRead * getBufferLength() / payload;
+    rxPendingFrames = readFrames < rxPendingFrames ? rxPendingFrames - readFrames : 0;
+    if (payload <= rxReadOffset) {
+      rxReadOffset = 0;
+      // 取りこぼしやイベントタイムアウトで読んだ周期数とずれないよう、送出済みのフレーム数から逆算する
+      const std::uint64_t end = capturedFrames - rxPendingFrames;
+      rxFrameIndex = getBufferLength() < end ? end - getBufferLength() : 0;
       rxFilled--;
       rxDone = true;  // バッファにreadが入っている
-      lastMsec = millis();
+      if (packed24 && (captureAnalyzer || captureActivityDetector)) {
+        AudioPack24::unpack(reinterpret_cast<const std::uint8_t*>(rxBuffer), pack24Scratch, payload / 4);
+      }
+      analyzeCapture(packed24 ? reinterpret_cast<const char*>(pack24Scratch) : rxBuffer);
+      lastEventMsec = millis();
     } else {
-      rxFilled = 0;
+      rxFilled = 0;  // 周期の途中まで。続きは次の RX_DONE で読む
     }
   }
 
+  _dispatchCallbacks();
   return true;
 }
 
+std::size_t I2SAudio::_writeDma(const char* data, std::size_t length) {
+  std::size_t bytesWritten = 0;
+#ifdef I2S_LEGACY_API_ENABLED
+  int bw = i2s_write_bytes(audioConfig.port, data, length, 0);
+  bytesWritten = (bw > 0) ? (std::size_t)bw : 0;
+#else
+  esp_err_t ret = i2s_write(audioConfig.port, data, length, &bytesWritten, 0);
+  if (ret != ESP_OK) bytesWritten = 0;
+#endif
+  return bytesWritten;
+}
+
+std::size_t I2SAudio::_readDma(char* data, std::size_t length, TickType_t ticks_to_wait) {
+#ifdef I2S_LEGACY_API_ENABLED
+  int bytesRead = i2s_read_bytes(audioConfig.port, data, length, ticks_to_wait);
+  if (bytesRead < 0) {
+    bytesRead = 0;
+  }
+#else
+  std::size_t bytesRead = 0;
+  esp_err_t ret = i2s_read(audioConfig.port, data, length, &bytesRead, ticks_to_wait);
+  if (ret != ESP_OK) {
+    bytesRead = 0;
+  }
+#endif
+  return (std::size_t)bytesRead;
+}
+
+std::size_t I2SAudio::_writePacked24Dma(const char* slot, std::size_t offset, std::size_t length) {
+  // 32bit への展開は DMA へ渡す直前に、小さな単位ずつ行う。周期全体をスタックに展開しない
+  std::int32_t chunk[Pack24ChunkSamples];
+  std::size_t written = 0;
+  while (written < length) {
+    const std::size_t pos = offset + written;
+    const std::size_t head = pos % 4;  // 前回サンプルの途中まで書けていた分
+    const std::size_t samples = std::min<std::size_t>(Pack24ChunkSamples, (head + length - written + 3) / 4);
+    AudioPack24::unpack(reinterpret_cast<const std::uint8_t*>(slot) + AudioPack24::packedSize(pos - head), chunk, samples);
+    const std::size_t want = std::min(samples * 4 - head, length - written);
+    const std::size_t n = _writeDma(reinterpret_cast<const char*>(chunk) + head, want);
+    written += n;
+    if (n < want) {
+      break;  // DMA が満杯
+    }
+  }
+  return written;
+}
+
+std::size_t I2SAudio::_readPacked24Dma(std::size_t offset, std::size_t length, TickType_t ticks_to_wait) {
+  std::int32_t chunk[Pack24ChunkSamples];
+  std::size_t read = 0;
+  while (read < length) {
+    const std::size_t want = std::min<std::size_t>(sizeof(chunk), length - read);
+    const std::size_t n = _readDma(reinterpret_cast<char*>(chunk), want, ticks_to_wait);
+    AudioPack24::pack(chunk, reinterpret_cast<std::uint8_t*>(rxBuffer) + AudioPack24::packedSize(offset + read), n / 4);
+    read += n;
+    if (n < want) {
+      break;  // 周期の途中まで。続きは次の RX_DONE で読む
+    }
+  }
+  return read;
+}
+
+void I2SAudio::setCaptureAnalyzer(AudioAnalyzer* analyzer) {
+  captureAnalyzer = analyzer;
+}
+
+void I2SAudio::setCaptureActivityDetector(AudioActivityDetector* detector) {
+  captureActivityDetector = detector;
+  captureSilent = false;
+}
+
+bool I2SAudio::isCaptureSilent() const {
+  return captureSilent;
+}
+
+void I2SAudio::analyzeCapture(const char* data) {
+  if (!captureAnalyzer && !captureActivityDetector) {
+    return;
+  }
+  switch (getAlignedBitLength()) {
+    case 16: {
+      const AudioBlock<const std::int16_t> block(
+        reinterpret_cast<const std::int16_t*>(data), getBufferLength(), getChannelNum());
+      if (captureActivityDetector) {
+        captureSilent = !captureActivityDetector->update(block);
+      }
+      if (captureAnalyzer) {
+        captureAnalyzer->analyze(block);
+      }
+    } break;
+    case 32: {
+      const AudioBlock<const std::int32_t> block(
+        reinterpret_cast<const std::int32_t*>(data), getBufferLength(), getChannelNum());
+      if (captureActivityDetector) {
+        captureSilent = !captureActivityDetector->update(block);
+      }
+      if (captureAnalyzer) {
+        captureAnalyzer->analyze(block);
+      }
+    } break;
+    default: { } break;
+  }
+}
+
+void I2SAudio::_dispatchCallbacks() {
+  if (dispatchingCallbacks || status != I2SAudioStart) {
+    return;
+  }
+  dispatchingCallbacks = true;
+  while (renderCallback && ringTxCount < getRingBufferCount()) {
+    const int count = ringTxCount;
+    renderTxSlot();
+    if (ringTxCount == count) {
+      break;  // 書き込めなかったので次回へ
+    }
+  }
+  if (captureCallback && rxDone) {
+    if (packed24) {
+      // rxDone はコールバックの後で下ろす。コールバック中の RX 読み出しで展開領域を上書きしない
+      AudioPack24::unpack(reinterpret_cast<const std::uint8_t*>(rxBuffer), pack24Scratch, I2SAudio::getPayloadSize() / 4);
+      captureCallback(reinterpret_cast<const std::uint8_t*>(pack24Scratch), getBufferLength(), captureCallbackArg);
+    } else {
+      captureCallback(reinterpret_cast<const std::uint8_t*>(rxBuffer), getBufferLength(), captureCallbackArg);
+    }
+    rxDone = false;
+  }
+  dispatchingCallbacks = false;
+}
+
+void I2SAudio::renderTxSlot() {
+  std::uint8_t* slot = reinterpret_cast<std::uint8_t*>(ringTxBuffer + ringTxWriteIdx * slotSize);
+  if (packed24) {
+    renderCallback(reinterpret_cast<std::uint8_t*>(pack24Scratch), getBufferLength(), renderCallbackArg);
+    AudioPack24::pack(pack24Scratch, slot, I2SAudio::getPayloadSize() / 4);
+  } else {
+    renderCallback(slot, getBufferLength(), renderCallbackArg);
+  }
+  commitTxSlot();
+}
+
+void I2SAudio::commitTxSlot() {
+  ringTxWriteIdx = (ringTxWriteIdx + 1) % getRingBufferCount();
+  ringTxCount++;
+  txIdleFilled = false;
+  txIdlePeriods = 0;
+  if (!txPrimed && ringTxCount >= getRingBufferCount()) {
+    txPrimed = true;
+  }
+}
+
+bool I2SAudio::process(std::uint32_t maxWaitMsec) {
+  if (status != I2SAudioStart) {
+    return false;
+  }
+  const bool ready = (renderCallback && ringTxCount < getRingBufferCount()) || rxDone;
+  if (!ready) {
+    // 空きも録音データもなければ、次の DMA イベントまで寝る
+    i2s_event_t event;
+    const TickType_t ticks = std::min((TickType_t)getDmaMsec()*getBufferCount(), (TickType_t)maxWaitMsec);
+    if (xQueuePeek(i2s_event_queue, &event, ticks) != pdTRUE) {
+      _eventQueue(0);
+      return false;
+    }
+  }
+  _eventQueue(0);
+  return true;
+}
 
 size_t I2SAudio::read(std::uint8_t* buffer, std::size_t length) {
   size_t s = 0;
@@ -315,24 +728,74 @@ size_t I2SAudio::read(std::uint8_t* buffer, std::size_t length) {
     _eventQueue(0);
   }
   if (rxDone) {
-    memcpy(buffer, rxBuffer, I2SAudio::getPayloadSize());
+    if (packed24) {
+      AudioPack24::unpack(reinterpret_cast<const std::uint8_t*>(rxBuffer),
+                          reinterpret_cast<std::int32_t*>(buffer), I2SAudio::getPayloadSize() / 4);
+    } else {
+      memcpy(buffer, rxBuffer, I2SAudio::getPayloadSize());
+    }
     rxDone = false;
     s = I2SAudio::getPayloadSize();
   }
   return s;
 }
 
+size_t I2SAudio::readTimestamped(std::uint8_t* buffer, std::size_t length, std::uint64_t* frameIndex) {
+  const size_t s = I2SAudio::read(buffer, length);
+  if (s && frameIndex) {
+    *frameIndex = rxFrameIndex;
+  }
+  return s;
+}
+
+std::uint64_t I2SAudio::getPlayedFrames() const {
+  return playedFrames;
+}
+
+std::uint64_t I2SAudio::getCapturedFrames() const {
+  return capturedFrames;
+}
+
+std::uint32_t I2SAudio::getOutputLatencyFrames() const {
+  const std::uint32_t dmaDepth = (std::uint32_t)getBufferCount() * i2sConfig.dma_buf_len;
+  const std::uint32_t pending = dmaPendingFrames;  // volatile のまま std::min には渡せない
+  const std::uint32_t inDma = std::min<std::uint32_t>(pending, dmaDepth);
+  return (std::uint32_t)(ringTxCount * getBufferLength()) + inDma;
+}
+
+std::uint32_t I2SAudio::getUnderrunCount() const {
+  return txUnderruns;
+}
+
+std::uint64_t I2SAudio::getLastCaptureFrameIndex() const {
+  return rxFrameIndex;
+}
+
+void I2SAudio::storeTxSlot(const std::uint8_t* payload) {
+  char* slot = ringTxBuffer + ringTxWriteIdx * slotSize;
+  if (packed24) {
+    AudioPack24::pack(reinterpret_cast<const std::int32_t*>(payload),
+                      reinterpret_cast<std::uint8_t*>(slot), I2SAudio::getPayloadSize() / 4);
+  } else {
+    memcpy(slot, payload, I2SAudio::getPayloadSize());
+  }
+  commitTxSlot();
+}
+
+bool I2SAudio::pushTxSlot(const std::uint8_t* payload) {
+  if (getRingBufferCount() <= ringTxCount) {
+    return false;
+  }
+  storeTxSlot(payload);
+  txPrimed = true;
+  return true;
+}
+
 size_t I2SAudio::write(const std::uint8_t* buffer, std::size_t length) {
   size_t s = 0;
+  resume();  // 一時停止中なら、ピン/クロックの設定を省いて再開する
   if (length <= I2SAudio::getPayloadSize() && ringTxCount < getRingBufferCount()) {
-    memcpy(ringTxBuffer + ringTxWriteIdx * I2SAudio::getPayloadSize(),
-           buffer, I2SAudio::getPayloadSize());
-    ringTxWriteIdx = (ringTxWriteIdx + 1) % getRingBufferCount();
-    ringTxCount++;
-    txIdleFilled = false;
-    if (!txPrimed && ringTxCount >= getRingBufferCount()) {
-      txPrimed = true;
-    }
+    storeTxSlot(buffer);
     s = I2SAudio::getPayloadSize();
   }
   _eventQueue(0);
@@ -340,6 +803,9 @@ size_t I2SAudio::write(const std::uint8_t* buffer, std::size_t length) {
 }
 
 int I2SAudio::availableForWrite() {
+  if(status == I2SAudioSuspend) {
+    return (getRingBufferCount() - ringTxCount) * I2SAudio::getPayloadSize();  // write() で再開する
+  }
   if(status != I2SAudioStart) {
     return 0;
   }
@@ -356,6 +822,9 @@ int I2SAudio::available() { /*ForRead*/
 }
 
 bool I2SAudio::waitForWritable(std::uint32_t maxWaitMsec) {
+  if(status == I2SAudioSuspend) {
+    return true;  // リングは空なので、すぐ書ける
+  }
   if(status != I2SAudioStart) {
     return false;  // 起動前は即リターン（delay不要）
   }
@@ -0,0 +1,80 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../I2SAudioGroup.h"
+#include <Arduino.h>
+#include <algorithm>
+
+I2SAudioGroup::I2SAudioGroup() : ports(), count(0) {
+}
+
+bool I2SAudioGroup::add(I2SAudio* audio) {
+  if (!audio || I2S_NUM_MAX <= count) {
+    return false;
+  }
+  ports[count++] = audio;
+  return true;
+}
+
+void I2SAudioGroup::begin() {
+  for (std::uint8_t i = 0; i < count; i++) {
+    ports[i]->begin();
+  }
+}
+
+void I2SAudioGroup::start() {
+  // ピン/クロック設定など時間のかかる準備は先に全ポート分済ませておく
+  for (std::uint8_t i = 0; i < count; i++) {
+    ports[i]->_prepareStart();
+  }
+  // i2s_start() の間にタスク切り替えが入らないようにし、同じ DMA 周期で開始させる
+  vTaskSuspendAll();
+  for (std::uint8_t i = 0; i < count; i++) {
+    i2s_start(ports[i]->audioConfig.port);
+  }
+  xTaskResumeAll();
+  for (std::uint8_t i = 0; i < count; i++) {
+    ports[i]->_finishStart(I2SAudio::I2SAudioStart);
+  }
+  for (std::uint8_t i = 0; i < count; i++) {
+    ports[i]->onStarted();
+  }
+}
+
+void I2SAudioGroup::stop() {
+  for (std::uint8_t i = 0; i < count; i++) {
+    ports[i]->stop();
+  }
+}
+
+bool I2SAudioGroup::pump(std::uint32_t maxWaitMsec) {
+  if (count == 0) {
+    return false;
+  }
+  bool pending = false;
+  for (std::uint8_t i = 0; i < count; i++) {
+    pending |= 0 < uxQueueMessagesWaiting(ports[i]->i2s_event_queue);
+  }
+  if (!pending && 0 < maxWaitMsec) {
+    // 同時に開始したポートのイベントはほぼ同時に来るので、先頭ポートだけを待つ
+    i2s_event_t event;
+    const TickType_t ticks = std::min((TickType_t)ports[0]->getBufferMsec()*ports[0]->getBufferCount(), (TickType_t)maxWaitMsec);
+    pending = xQueuePeek(ports[0]->i2s_event_queue, &event, ticks) == pdTRUE;
+  }
+  for (std::uint8_t i = 0; i < count; i++) {
+    if (ports[i]->status != I2SAudio::I2SAudioStop) {
+      ports[i]->_eventQueue(0);
+    }
+  }
+  return pending;
+}
+
+std::uint8_t I2SAudioGroup::getCount() const {
+  return count;
+}
+
+I2SAudio* I2SAudioGroup::get(std::uint8_t index) const {
+  return index < count ? ports[index] : nullptr;
+}
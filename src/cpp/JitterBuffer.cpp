@@ -0,0 +1,296 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../JitterBuffer.h"
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <string.h>
+
+/**
+ * @brief 2〜64 の 2 の累乗に切り上げる
+ */
+static std::uint8_t roundSlotCount(std::uint8_t n) {
+  std::uint8_t count = 2;
+  while (count < n && count < 64) {
+    count <<= 1;
+  }
+  return count;
+}
+
+JitterBuffer::JitterBuffer(const Audio& output, std::uint8_t slotCount, std::uint8_t minDepth) :
+  output(output), payloadSize(output.getPayloadSize()), frames(output.getBufferLength()),
+  sampleBytes((std::uint8_t)((output.getAlignedBitLength() + 7) / 8)),
+  channels((std::uint8_t)(output.getPayloadSize() / (output.getBufferLength() * ((output.getAlignedBitLength() + 7) / 8)))),
+  sampleRate(output.getSampRate()),
+  periodMicros((std::uint32_t)((std::uint64_t)output.getBufferLength() * 1000000 / output.getSampRate())),
+  slotCount(roundSlotCount(slotCount)),
+  minDepth(minDepth < 1 ? 1 : minDepth),
+  pool(new std::uint8_t[payloadSize * this->slotCount]), slotSequence(new std::uint16_t[this->slotCount]),
+  slotValid(new bool[this->slotCount]), lastPayload(new std::uint8_t[payloadSize]) {
+  reset();
+}
+
+JitterBuffer::~JitterBuffer() {
+  delete[] pool;
+  delete[] slotSequence;
+  delete[] slotValid;
+  delete[] lastPayload;
+}
+
+void JitterBuffer::reset() {
+  memset(slotValid, 0, slotCount * sizeof(bool));
+  bufferedCount = 0;
+  nextSequence = 0;
+  highestSequence = 0;
+  playedSequence = 0;
+  targetDepth = minDepth < slotCount ? minDepth : slotCount - 1;
+  playing = false;
+  hasPlayed = false;
+  endOfStream = false;
+  hasLast = false;
+  hasArrival = false;
+  lastTimestamp = 0;
+  lastArrivalMicros = 0;
+  jitterQ4 = 0;
+  concealRun = 0;
+  outputGain = 0x8000;
+  received = 0;
+  concealed = 0;
+  late = 0;
+  duplicates = 0;
+  overflows = 0;
+  trimmed = 0;
+  rebuffers = 0;
+}
+
+void JitterBuffer::updateJitter(std::uint32_t timestamp, std::uint32_t arrivalMicros) {
+  if (hasArrival) {
+    // RFC 3550 6.4.1: D = (Rj - Ri) - (Sj - Si)、J += (|D| - J) / 16
+    const std::int64_t sent = (std::int64_t)(std::int32_t)(timestamp - lastTimestamp) * 1000000 / sampleRate;
+    const std::int64_t d = (std::int64_t)(std::int32_t)(arrivalMicros - lastArrivalMicros) - sent;
+    const std::int64_t limit = 10000000;  // 10 秒を超える差は打ち切る
+    const std::uint32_t ad = (std::uint32_t)(d < 0 ? (-d < limit ? -d : limit) : (d < limit ? d : limit));
+    jitterQ4 = jitterQ4 + ad - ((jitterQ4 + 8) >> 4);
+  }
+  lastTimestamp = timestamp;
+  lastArrivalMicros = arrivalMicros;
+  hasArrival = true;
+}
+
+void JitterBuffer::updateTargetDepth() {
+  const std::uint32_t margin = (getJitterMicros() * JitterMultiplier + periodMicros - 1) / periodMicros;
+  std::uint32_t depth = 1 + margin;
+  if (depth < minDepth) {
+    depth = minDepth;
+  }
+  if (slotCount <= depth) {
+    depth = slotCount - 1;
+  }
+  targetDepth = (std::uint8_t)depth;
+}
+
+bool JitterBuffer::formatChanged() const {
+  return output.getPayloadSize() != payloadSize || output.getSampRate() != sampleRate;
+}
+
+#ifdef ARDUINO
+bool JitterBuffer::push(std::uint16_t sequence, std::uint32_t timestamp, const std::uint8_t* payload, std::size_t length) {
+  return push(sequence, timestamp, payload, length, micros());
+}
+#endif
+
+std::uint8_t JitterBuffer::slotIndex(std::uint16_t sequence) const {
+  return (std::uint8_t)(sequence & (slotCount - 1));  // slotCount は 65536 を割り切るので、番号が一巡しても窓の中で重ならない
+}
+
+bool JitterBuffer::push(std::uint16_t sequence, std::uint32_t timestamp, const std::uint8_t* payload, std::size_t length, std::uint32_t arrivalMicros) {
+  if (length != payloadSize || formatChanged()) {
+    return false;
+  }
+  received++;
+  if (hasPlayed && (std::int16_t)(sequence - playedSequence) < 0) {
+    late++;  // 溜め直す前に再生済み。古い到着時刻で揺らぎの推定を崩さないよう、ここで捨てる
+    return false;
+  }
+  updateJitter(timestamp, arrivalMicros);
+  updateTargetDepth();
+  if (!playing && bufferedCount == 0) {
+    nextSequence = sequence;
+    highestSequence = sequence;
+  }
+  const std::int16_t ahead = (std::int16_t)(sequence - nextSequence);
+  if (ahead < 0) {
+    if (playing || hasPlayed || slotCount <= (std::int16_t)(highestSequence - sequence)) {
+      late++;  // 再生済み、または窓に収まらない
+      return false;
+    }
+    nextSequence = sequence;  // 一度も再生していなければ先頭を前へ広げる
+  } else if (slotCount <= ahead) {
+    overflows++;
+    return false;
+  }
+  const std::uint8_t index = slotIndex(sequence);
+  if (slotValid[index]) {
+    duplicates++;
+    return false;
+  }
+  memcpy(pool + index * payloadSize, payload, payloadSize);
+  slotSequence[index] = sequence;
+  slotValid[index] = true;
+  bufferedCount++;
+  if (0 < (std::int16_t)(sequence - highestSequence)) {
+    highestSequence = sequence;
+  }
+  return true;
+}
+
+void JitterBuffer::setEndOfStream() {
+  endOfStream = true;
+}
+
+template<class T>
+void JitterBuffer::ramp(T* data, std::int32_t from, std::int32_t to) {
+  for (std::size_t i = 0; i < frames; i++) {
+    // フレームごとに線形にゲインを進める (Q15)
+    const std::int32_t gain = from + (std::int32_t)(((std::int64_t)(to - from) * (std::int64_t)i) / (std::int64_t)frames);
+    for (std::uint8_t c = 0; c < channels; c++) {
+      data[i * channels + c] = (T)(((std::int64_t)data[i * channels + c] * gain) >> 15);
+    }
+  }
+}
+
+void JitterBuffer::conceal(std::uint8_t* buffer) {
+  const std::int32_t unity = 0x8000;
+  if (hasLast && concealRun < FadePeriods && (sampleBytes == 2 || sampleBytes == 4)) {
+    // 直前の周期を繰り返し、FadePeriods 周期かけて 0 まで絞る
+    const std::int32_t to = unity * (FadePeriods - concealRun - 1) / FadePeriods;
+    memcpy(buffer, lastPayload, payloadSize);
+    if (sampleBytes == 2) {
+      ramp(reinterpret_cast<std::int16_t*>(buffer), outputGain, to);
+    } else {
+      ramp(reinterpret_cast<std::int32_t*>(buffer), outputGain, to);
+    }
+    outputGain = to;
+  } else {
+    memset(buffer, 0, payloadSize);
+    outputGain = 0;
+  }
+  if (concealRun < 0xFF) {
+    concealRun++;
+  }
+}
+
+std::size_t JitterBuffer::read(std::uint8_t* buffer, std::size_t byteLength) {
+  if (byteLength != payloadSize || formatChanged()) {
+    return 0;
+  }
+  if (!playing) {
+    if (bufferedCount == 0 || (!endOfStream && getDepth() < targetDepth)) {
+      memset(buffer, 0, byteLength);  // 溜まるまでは無音
+      return byteLength;
+    }
+    playing = true;
+  }
+  if (targetDepth + TrimSlack < getDepth()) {
+    // 揺らぎが収まって溜まりすぎたので、1 周期ずつ間引いて遅延を詰める
+    const std::uint8_t index = slotIndex(nextSequence);
+    if (slotValid[index]) {
+      slotValid[index] = false;
+      bufferedCount--;
+    }
+    nextSequence++;
+    trimmed++;
+  }
+  const std::uint8_t index = slotIndex(nextSequence);
+  if (slotValid[index] && slotSequence[index] == nextSequence) {
+    const std::uint8_t* slot = pool + index * payloadSize;
+    memcpy(lastPayload, slot, payloadSize);
+    memcpy(buffer, slot, payloadSize);
+    slotValid[index] = false;
+    bufferedCount--;
+    if (outputGain < 0x8000 && (sampleBytes == 2 || sampleBytes == 4)) {
+      // 補間や溜め直しの後は、絞ったゲインから戻す
+      if (sampleBytes == 2) {
+        ramp(reinterpret_cast<std::int16_t*>(buffer), outputGain, 0x8000);
+      } else {
+        ramp(reinterpret_cast<std::int32_t*>(buffer), outputGain, 0x8000);
+      }
+    }
+    outputGain = 0x8000;
+    hasLast = true;
+    concealRun = 0;
+    nextSequence++;
+  } else {
+    conceal(buffer);
+    concealed++;
+    if (targetDepth <= getDepth()) {
+      nextSequence++;  // 後続が十分届いているので失われたとみなす
+    }
+    // 後続が足りないときは遅れているだけとみなし、同じ周期を待つ (遅延が 1 周期延びる)
+  }
+  hasPlayed = true;
+  playedSequence = nextSequence;
+  if (bufferedCount == 0 && (endOfStream || FadePeriods <= concealRun)) {
+    // 補間しきっても届かないので、目標の遅延まで溜め直す
+    playing = false;
+    if (!endOfStream) {
+      rebuffers++;
+    }
+  }
+  return byteLength;
+}
+
+bool JitterBuffer::finished() const {
+  return endOfStream && bufferedCount == 0;
+}
+
+bool JitterBuffer::isPlaying() const {
+  return playing;
+}
+
+std::uint8_t JitterBuffer::getDepth() const {
+  if (bufferedCount == 0) {
+    return 0;
+  }
+  const std::int16_t depth = (std::int16_t)(highestSequence - nextSequence) + 1;
+  return depth < 0 ? 0 : (std::uint8_t)depth;
+}
+
+std::uint8_t JitterBuffer::getTargetDepth() const {
+  return targetDepth;
+}
+
+std::uint32_t JitterBuffer::getJitterMicros() const {
+  return jitterQ4 >> 4;
+}
+
+std::uint32_t JitterBuffer::getReceived() const {
+  return received;
+}
+
+std::uint32_t JitterBuffer::getConcealed() const {
+  return concealed;
+}
+
+std::uint32_t JitterBuffer::getLate() const {
+  return late;
+}
+
+std::uint32_t JitterBuffer::getDuplicates() const {
+  return duplicates;
+}
+
+std::uint32_t JitterBuffer::getOverflows() const {
+  return overflows;
+}
+
+std::uint32_t JitterBuffer::getTrimmed() const {
+  return trimmed;
+}
+
+std::uint32_t JitterBuffer::getRebuffers() const {
+  return rebuffers;
+}
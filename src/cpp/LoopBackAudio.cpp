@@ -22,6 +22,9 @@ LoopBackAudio::~LoopBackAudio() {
 void LoopBackAudio::begin() {}
 void LoopBackAudio::start() {
   readable = false;
+  playedFrames = 0;
+  capturedFrames = 0;
+  underruns = 0;
   writeTargetMsec = millis();
 }
 void LoopBackAudio::stop() {}
@@ -49,6 +52,7 @@ size_t LoopBackAudio::read(std::uint8_t *buffer, std::size_t length) {
   if (readable) {
     readable = false;
     memcpy(buffer, echoBuffer, length);
+    capturedFrames += length * getBufferLength() / getPayloadSize();
     xSemaphoreGive(xSemaphore);
     return length;
   } else {
@@ -61,9 +65,13 @@ size_t LoopBackAudio::write(const uint8_t *buffer, size_t length) {
   // length==getBufferLength()*bitRate/8
   if (length <= availableForWrite()) {
     const uint32_t bufferMsec = 1000 * length * 8 / (getAlignedBitLength() * getSampRate());
+    if (0 < playedFrames && (int)(millis() - writeTargetMsec) >= (int)bufferMsec) {
+      underruns++;  // 1 周期以上書き込みが遅れた。最初の書き込みまでの空きは数えない
+    }
     writeTargetMsec += bufferMsec;
     xSemaphoreTake(xSemaphore, portMAX_DELAY);
     memcpy(echoBuffer, buffer, length);
+    playedFrames += length * getBufferLength() / getPayloadSize();
     readable = true;
     xSemaphoreGive(xSemaphore);
     return length;
@@ -71,3 +79,12 @@ size_t LoopBackAudio::write(const uint8_t *buffer, size_t length) {
     return 0;
   }
 }
+std::uint64_t LoopBackAudio::getPlayedFrames() const {
+  return playedFrames;
+}
+std::uint64_t LoopBackAudio::getCapturedFrames() const {
+  return capturedFrames;
+}
+std::uint32_t LoopBackAudio::getUnderrunCount() const {
+  return underruns;
+}
@@ -0,0 +1,146 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../PlaybackScheduler.h"
+#include <string.h>
+
+PlaybackScheduler::PlaybackScheduler(const Audio& output) :
+  output(output), payloadSize(output.getPayloadSize()), frames(output.getBufferLength()),
+  sampleBytes((std::uint8_t)((output.getAlignedBitLength() + 7) / 8)),
+  channels((std::uint8_t)(output.getPayloadSize() / (output.getBufferLength() * ((output.getAlignedBitLength() + 7) / 8)))),
+  queue(), queueHead(0), queueCount(0), current(nullptr), fading(nullptr),
+  fadeFrames(0), fadePosition(0), underflows(0) {
+}
+
+bool PlaybackScheduler::enqueue(AudioSource* source) {
+  if (!source || MaxQueue <= queueCount) {
+    return false;
+  }
+  queue[(queueHead + queueCount) % MaxQueue] = source;
+  queueCount++;
+  return true;
+}
+
+bool PlaybackScheduler::advance() {
+  if (queueCount == 0) {
+    current = nullptr;
+    return false;
+  }
+  current = queue[queueHead];
+  queueHead = (queueHead + 1) % MaxQueue;
+  queueCount--;
+  return true;
+}
+
+bool PlaybackScheduler::skip(std::uint8_t crossfadePeriods) {
+  if (queueCount == 0 || fading) {
+    return false;  // フェードアウト中のソースを途中で外すと段差が出る
+  }
+  AudioSource* previous = current;
+  advance();
+  if (previous && crossfadePeriods && (sampleBytes == 2 || sampleBytes == 4)) {
+    fading = previous;
+    fadeFrames = (std::uint32_t)crossfadePeriods * frames;
+    fadePosition = 0;
+  } else {
+    fading = nullptr;
+  }
+  return true;
+}
+
+void PlaybackScheduler::clear() {
+  queueCount = 0;
+  current = nullptr;
+  fading = nullptr;
+}
+
+std::size_t PlaybackScheduler::readSource(AudioSource* source, std::uint8_t* buffer, std::size_t byteLength, bool isCurrent) {
+  const std::size_t frameBytes = payloadSize / frames;
+  std::size_t filled = 0;
+  while (source && filled < byteLength) {
+    std::size_t n = source->read(buffer + filled, byteLength - filled);
+    n -= n % frameBytes;
+    filled += n;
+    if (filled == byteLength) {
+      break;
+    }
+    if (!source->finished()) {
+      if (isCurrent) {
+        underflows++;  // データが間に合わない。残りは無音
+      }
+      break;
+    }
+    if (!isCurrent) {
+      break;  // フェードアウト中のソースが終わった。残りは無音
+    }
+    advance();  // 同じ payload の続きから次のソースを読む
+    source = current;
+  }
+  memset(buffer + filled, 0, byteLength - filled);
+  return filled;
+}
+
+template<class T>
+void PlaybackScheduler::mix(T* in, const T* out, std::size_t n) {
+  const std::int32_t unity = 0x8000;
+  for (std::size_t i = 0; i < n; i++) {
+    // フレームごとに線形にゲインを進める (Q15)
+    const std::uint32_t position = fadePosition + (std::uint32_t)i;
+    const std::int32_t gain = position < fadeFrames ? (std::int32_t)(((std::uint64_t)position * unity) / fadeFrames) : unity;
+    for (std::uint8_t c = 0; c < channels; c++) {
+      const std::int64_t v = (std::int64_t)in[i * channels + c] * gain + (std::int64_t)out[i * channels + c] * (unity - gain);
+      in[i * channels + c] = (T)(v >> 15);
+    }
+  }
+}
+
+std::size_t PlaybackScheduler::read(std::uint8_t* buffer, std::size_t byteLength) {
+  if (payloadSize != output.getPayloadSize()) {
+    payloadSize = output.getPayloadSize();  // 出力先の reconfigure() に追従する。ソースの読み位置はそのまま
+    frames = output.getBufferLength();
+  }
+  if (byteLength != payloadSize) {
+    return 0;
+  }
+  if (!current) {
+    advance();
+  }
+  std::size_t n = readSource(current, buffer, byteLength, true);
+  if (fading) {
+    std::uint8_t out[byteLength];
+    readSource(fading, out, byteLength, false);
+    if (sampleBytes == 2) {
+      mix(reinterpret_cast<std::int16_t*>(buffer), reinterpret_cast<const std::int16_t*>(out), frames);
+    } else {
+      mix(reinterpret_cast<std::int32_t*>(buffer), reinterpret_cast<const std::int32_t*>(out), frames);
+    }
+    fadePosition += frames;
+    if (fadeFrames <= fadePosition) {
+      fading = nullptr;
+    }
+    n = byteLength;
+  }
+  return n;
+}
+
+bool PlaybackScheduler::finished() const {
+  return !current && !fading && queueCount == 0;
+}
+
+AudioSource* PlaybackScheduler::getCurrent() const {
+  return current;
+}
+
+std::uint8_t PlaybackScheduler::getQueuedCount() const {
+  return queueCount;
+}
+
+bool PlaybackScheduler::isCrossfading() const {
+  return fading != nullptr;
+}
+
+std::uint32_t PlaybackScheduler::getUnderflows() const {
+  return underflows;
+}
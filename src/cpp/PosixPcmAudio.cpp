@@ -0,0 +1,165 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../PosixPcmAudio.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NSEC_PER_SEC 1000000000LL
+
+PosixPcmAudio::PosixPcmAudio(std::uint16_t sampleRate, std::uint8_t bitDepth, std::uint16_t bufferMsec, std::uint8_t channelNum,
+                             int inFd, int outFd, bool paced):
+  super(sampleRate, bitDepth, bitDepth, bufferMsec, channelNum),
+  inFd(inFd), outFd(outFd), paced(paced), epoch() {
+}
+
+void PosixPcmAudio::begin() {}
+void PosixPcmAudio::start() {
+  clock_gettime(CLOCK_MONOTONIC, &epoch);
+  playedFrames = 0;
+  capturedFrames = 0;
+  underruns = 0;
+}
+void PosixPcmAudio::stop() {}
+void PosixPcmAudio::zero() {}
+
+std::uint64_t PosixPcmAudio::elapsedFrames() const {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  const std::int64_t nsec = (now.tv_sec - epoch.tv_sec) * NSEC_PER_SEC + (now.tv_nsec - epoch.tv_nsec);
+  return nsec <= 0 ? 0 : (std::uint64_t)nsec * getSampRate() / NSEC_PER_SEC;
+}
+
+void PosixPcmAudio::sleepUntil(std::uint64_t frames, std::uint32_t maxWaitMsec) const {
+  const std::uint64_t elapsed = elapsedFrames();
+  if (frames <= elapsed) {
+    return;
+  }
+  std::uint64_t nsec = ((frames - elapsed) * NSEC_PER_SEC + getSampRate() - 1) / getSampRate();
+  if ((std::uint64_t)maxWaitMsec * 1000000 < nsec) {
+    nsec = (std::uint64_t)maxWaitMsec * 1000000;
+  }
+  const struct timespec t = {(time_t)(nsec / NSEC_PER_SEC), (long)(nsec % NSEC_PER_SEC)};
+  nanosleep(&t, nullptr);
+}
+
+int PosixPcmAudio::availableForWrite() {
+  // 実デバイスと同じく、先行できるのは 1 周期分まで
+  if (!paced || playedFrames < elapsedFrames() + getBufferLength()) {
+    return getPayloadSize();
+  } else {
+    return 0;
+  }
+}
+
+int PosixPcmAudio::available() {
+  if (inputEnd) {
+    return 0;
+  }
+  if (!paced || capturedFrames + getBufferLength() <= elapsedFrames()) {
+    return getPayloadSize();
+  } else {
+    return 0;
+  }
+}
+
+bool PosixPcmAudio::waitForWritable(std::uint32_t maxWaitMsec) {
+  if (paced && availableForWrite() < (int)getPayloadSize()) {
+    sleepUntil(playedFrames - getBufferLength() + 1, maxWaitMsec);
+  }
+  return (int)getPayloadSize() <= availableForWrite();
+}
+
+bool PosixPcmAudio::waitForReadable(std::uint32_t maxWaitMsec) {
+  if (paced && available() < (int)getPayloadSize() && !inputEnd) {
+    sleepUntil(capturedFrames + getBufferLength(), maxWaitMsec);
+  }
+  return (int)getPayloadSize() <= available();
+}
+
+std::size_t PosixPcmAudio::read(std::uint8_t *buffer, std::size_t length) {
+  if (available() < (int)getPayloadSize()) {
+    return 0;
+  }
+  std::size_t n = 0;
+  if (inFd < 0) {
+    memset(buffer, 0, length);
+    n = length;
+  }
+  while (n < length) {
+    const ssize_t r = ::read(inFd, buffer + n, length - n);
+    if (r < 0 && errno == EINTR) {
+      continue;
+    }
+    if (r <= 0) {
+      inputEnd = true;  // 端数のフレームは返さない
+      break;
+    }
+    n += r;
+  }
+  const std::size_t frameBytes = getPayloadSize() / getBufferLength();
+  n -= n % frameBytes;
+  capturedFrames += n / frameBytes;
+  return n;
+}
+
+std::size_t PosixPcmAudio::write(const std::uint8_t *buffer, std::size_t length) {
+  if (availableForWrite() < (int)getPayloadSize()) {
+    return 0;
+  }
+  const std::size_t frameBytes = getPayloadSize() / getBufferLength();
+  if (paced) {
+    const std::uint64_t elapsed = elapsedFrames();
+    if (0 < playedFrames && playedFrames + getBufferLength() <= elapsed) {
+      underruns++;  // 1 周期以上書き込みが遅れた。遅れた分は再生されなかったものとして時刻を合わせる
+      const std::int64_t lateNsec = (std::int64_t)((elapsed - playedFrames) * NSEC_PER_SEC / getSampRate());
+      epoch.tv_sec += lateNsec / NSEC_PER_SEC;
+      epoch.tv_nsec += lateNsec % NSEC_PER_SEC;
+      if (NSEC_PER_SEC <= epoch.tv_nsec) {
+        epoch.tv_sec++;
+        epoch.tv_nsec -= NSEC_PER_SEC;
+      }
+    }
+  }
+  std::size_t n = 0;
+  while (0 <= outFd && n < length) {
+    const ssize_t w = ::write(outFd, buffer + n, length - n);
+    if (w < 0 && errno == EINTR) {
+      continue;
+    }
+    if (w <= 0) {
+      playedFrames += n / frameBytes;  // EPIPE など。書けた分だけ進めて返す
+      return n;
+    }
+    n += w;
+  }
+  playedFrames += length / frameBytes;
+  return length;
+}
+
+std::uint64_t PosixPcmAudio::getPlayedFrames() const {
+  return playedFrames;
+}
+
+std::uint64_t PosixPcmAudio::getCapturedFrames() const {
+  return capturedFrames;
+}
+
+std::uint32_t PosixPcmAudio::getOutputLatencyFrames() const {
+  if (!paced) {
+    return 0;
+  }
+  const std::uint64_t elapsed = elapsedFrames();
+  return elapsed < playedFrames ? (std::uint32_t)(playedFrames - elapsed) : 0;
+}
+
+std::uint32_t PosixPcmAudio::getUnderrunCount() const {
+  return underruns;
+}
+
+bool PosixPcmAudio::isInputEnd() const {
+  return inputEnd;
+}
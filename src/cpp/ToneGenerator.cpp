@@ -0,0 +1,146 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../ToneGenerator.h"
+#include <math.h>
+
+#define SINE_TABLE_BITS 8
+#define SINE_TABLE_SIZE (1 << SINE_TABLE_BITS)
+
+// 補間用に 1 点多く持つ。初回の ToneGenerator 生成時に作る
+static std::int16_t sineTable[SINE_TABLE_SIZE + 1];
+static bool sineTableReady = false;
+
+static void initSineTable() {
+  if (sineTableReady) {
+    return;
+  }
+  for (int i = 0; i <= SINE_TABLE_SIZE; i++) {
+    sineTable[i] = (std::int16_t)lround(32767.0 * sin(2.0 * M_PI * i / SINE_TABLE_SIZE));
+  }
+  sineTableReady = true;
+}
+
+ToneGenerator::ToneGenerator(std::uint16_t sampleRate) :
+  sampleRate(sampleRate), waveform(Sine), oscillatorNum(0), oscillators() {
+  initSineTable();
+}
+
+std::uint32_t ToneGenerator::toIncrement(float frequency) const {
+  if (frequency <= 0.0f || sampleRate <= 2.0f * frequency) {
+    return 0;
+  }
+  return (std::uint32_t)((double)frequency * 4294967296.0 / sampleRate);
+}
+
+void ToneGenerator::setTone(Waveform w, float frequency, std::int16_t amplitude) {
+  waveform = w;
+  oscillatorNum = 1;
+  oscillators[0].increment = toIncrement(frequency);
+  oscillators[0].incrementDelta = 0;
+  oscillators[0].sweepRemaining = 0;
+  oscillators[0].amplitude = amplitude;
+}
+
+bool ToneGenerator::setDtmf(char key, std::int16_t amplitude) {
+  static const char keys[4][4] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'},
+  };
+  static const float rowFrequency[4] = {697.0f, 770.0f, 852.0f, 941.0f};
+  static const float colFrequency[4] = {1209.0f, 1336.0f, 1477.0f, 1633.0f};
+  for (int r = 0; r < 4; r++) {
+    for (int c = 0; c < 4; c++) {
+      if (keys[r][c] == key) {
+        setTone(Sine, rowFrequency[r], amplitude / 2);
+        oscillatorNum = 2;
+        oscillators[1].increment = toIncrement(colFrequency[c]);
+        oscillators[1].incrementDelta = 0;
+        oscillators[1].sweepRemaining = 0;
+        oscillators[1].amplitude = amplitude / 2;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ToneGenerator::setSweep(Waveform w, float startFrequency, float endFrequency, std::uint32_t sweepMsec, std::int16_t amplitude) {
+  setTone(w, startFrequency, amplitude);
+  const std::uint32_t samples = (std::uint32_t)sampleRate * sweepMsec / 1000;
+  if (0 < samples) {
+    const double delta = ((double)toIncrement(endFrequency) - (double)oscillators[0].increment) / samples;
+    oscillators[0].incrementDelta = (std::int32_t)delta;
+    oscillators[0].sweepRemaining = samples;
+  }
+}
+
+void ToneGenerator::silence() {
+  oscillatorNum = 0;
+}
+
+void ToneGenerator::reset() {
+  oscillators[0].phase = 0;
+  oscillators[1].phase = 0;
+}
+
+std::int32_t ToneGenerator::sample(Oscillator& osc) const {
+  const std::uint32_t phase = osc.phase;
+  osc.phase += osc.increment;
+  if (osc.sweepRemaining) {
+    osc.increment += osc.incrementDelta;
+    osc.sweepRemaining--;
+  }
+  std::int32_t v;
+  switch (waveform) {
+    case Sine: {
+      const std::uint32_t index = phase >> (32 - SINE_TABLE_BITS);
+      const std::int32_t frac = (phase >> (16 - SINE_TABLE_BITS)) & 0xFFFF;
+      const std::int32_t a = sineTable[index];
+      const std::int32_t b = sineTable[index + 1];
+      v = a + (((b - a) * frac) >> 16);
+    } break;
+    case Square: {
+      v = (phase < 0x80000000U) ? 32767 : -32767;
+    } break;
+    case Triangle: {
+      // 0 -> +1 -> -1 -> 0
+      const std::int32_t x = (std::int32_t)(phase >> 16);
+      if (x < 0x4000) {
+        v = x * 2;
+      } else if (x < 0xC000) {
+        v = 0x10000 - x * 2;
+      } else {
+        v = x * 2 - 0x20000;
+      }
+      v = (v < 32767) ? v : 32767;
+    } break;
+    case Sawtooth:
+    default: {
+      v = (std::int32_t)(phase >> 16) - 32768;
+    } break;
+  }
+  return (v * osc.amplitude) >> 15;
+}
+
+void ToneGenerator::render(std::int16_t* buffer, std::size_t frames, std::uint8_t channelNum) {
+  render(AudioBlock<std::int16_t>(buffer, frames, channelNum));
+}
+
+void ToneGenerator::render(const AudioBlock<std::int16_t>& block) {
+  for (std::size_t i = 0; i < block.frames; i++) {
+    std::int32_t v = 0;
+    for (std::uint8_t o = 0; o < oscillatorNum; o++) {
+      v += sample(oscillators[o]);
+    }
+    const std::int16_t s = (std::int16_t)(v < INT16_MIN ? INT16_MIN : (INT16_MAX < v ? INT16_MAX : v));
+    std::int16_t* f = block.frame(i);
+    for (std::uint8_t c = 0; c < block.channels; c++) {
+      f[c] = s;
+    }
+  }
+}
@@ -0,0 +1,220 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../WavFileSource.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define READER_STOP 0xFF  // freeQueue に積むと読み込みタスクが終了する
+
+WavFileSource::WavFileSource(const Audio& output, std::uint8_t blockCount) :
+  sampleRate(output.getSampRate()), payloadSize(output.getPayloadSize()), frames(output.getBufferLength()),
+  outChannels((std::uint8_t)(output.getPayloadSize() / (output.getBufferLength() * ((output.getAlignedBitLength() + 7) / 8)))),
+  outBytes((std::uint8_t)((output.getAlignedBitLength() + 7) / 8)),
+  periodMicros((std::uint32_t)((std::uint64_t)output.getBufferLength() * 1000000 / output.getSampRate())),
+  blockCount(blockCount < READER_STOP ? blockCount : READER_STOP - 1),
+  pool(new std::uint8_t[payloadSize * blockCount]), blockLength(new std::size_t[blockCount]),
+  freeQueue(xQueueCreate(blockCount + 1, sizeof(std::uint8_t))),
+  readyQueue(xQueueCreate(blockCount, sizeof(std::uint8_t))),
+  readerDone(xSemaphoreCreateBinary()),
+  file(nullptr), header(), raw(nullptr), remainingBytes(0), eof(true),
+  maxFetchMicros(0), hiddenStalls(0), underflows(0) {
+}
+
+WavFileSource::~WavFileSource() {
+  close();
+  vQueueDelete(freeQueue);
+  vQueueDelete(readyQueue);
+  vSemaphoreDelete(readerDone);
+  delete[] pool;
+  delete[] blockLength;
+}
+
+bool WavFileSource::open(const char* path, UBaseType_t priority) {
+  if (file) {
+    return false;
+  }
+  file = fopen(path, "rb");
+  if (!file) {
+    log_e("WavFileSource: cannot open %s", path);
+    return false;
+  }
+  if (!header.read(file)) {
+    log_e("WavFileSource: %s is not a PCM WAV", path);
+  } else if (header.bitsPerSample != 8 && header.bitsPerSample != 16 &&
+             header.bitsPerSample != 24 && header.bitsPerSample != 32) {
+    log_e("WavFileSource: %u bits is not supported", header.bitsPerSample);
+  } else if (header.sampleRate != sampleRate) {
+    log_e("WavFileSource: %u Hz does not match the output", header.sampleRate);  // 周波数変換はしない
+  } else if (outBytes != 2 && outBytes != 4) {
+    log_e("WavFileSource: output %u bytes/sample is not supported", outBytes);
+  } else {
+    const bool direct = header.channels == outChannels && header.bitsPerSample == outBytes * 8;
+    raw = direct ? nullptr : new std::uint8_t[frames * header.getBlockAlign()];
+    remainingBytes = header.dataBytes - header.dataBytes % header.getBlockAlign();
+    eof = false;
+    maxFetchMicros = 0;
+    hiddenStalls = 0;
+    underflows = 0;
+    xQueueReset(freeQueue);
+    xQueueReset(readyQueue);
+    xSemaphoreTake(readerDone, 0);
+    for (std::uint8_t i = 0; i < blockCount; i++) {
+      xQueueSend(freeQueue, &i, 0);
+    }
+    if (xTaskCreate(readerTask, "WavFileSource", 4096, this, priority, nullptr) == pdPASS) {
+      return true;
+    }
+    delete[] raw;
+    raw = nullptr;
+    eof = true;
+  }
+  fclose(file);
+  file = nullptr;
+  return false;
+}
+
+void WavFileSource::close() {
+  if (!file) {
+    return;
+  }
+  const std::uint8_t stop = READER_STOP;
+  xQueueSend(freeQueue, &stop, portMAX_DELAY);  // 終端で抜けていた場合は積まれたまま残り、次の open() で消える
+  xSemaphoreTake(readerDone, portMAX_DELAY);
+  fclose(file);
+  file = nullptr;
+  delete[] raw;
+  raw = nullptr;
+  eof = true;
+}
+
+std::size_t WavFileSource::read(std::uint8_t* buffer, std::size_t byteLength) {
+  std::uint8_t index;
+  if (xQueueReceive(readyQueue, &index, 0) != pdTRUE) {
+    if (!eof) {
+      underflows++;  // 先読みが間に合っていない
+    }
+    return 0;
+  }
+  const std::size_t n = blockLength[index] < byteLength ? blockLength[index] : byteLength;
+  memcpy(buffer, pool + index * payloadSize, n);
+  xQueueSend(freeQueue, &index, 0);
+  return n;
+}
+
+bool WavFileSource::finished() const {
+  return eof && uxQueueMessagesWaiting(readyQueue) == 0;
+}
+
+void WavFileSource::readerTask(void* arg) {
+  static_cast<WavFileSource*>(arg)->readLoop();
+  vTaskDelete(nullptr);
+}
+
+void WavFileSource::readLoop() {
+  std::uint8_t index;
+  while (0 < remainingBytes && xQueueReceive(freeQueue, &index, portMAX_DELAY) == pdTRUE && index != READER_STOP) {
+    const std::uint32_t start = micros();
+    const std::size_t n = fetch(pool + index * payloadSize);
+    const std::uint32_t elapsed = micros() - start;
+    if (maxFetchMicros < elapsed) {
+      maxFetchMicros = elapsed;
+    }
+    if (periodMicros < elapsed) {
+      hiddenStalls++;
+    }
+    if (n == 0) {
+      xQueueSend(freeQueue, &index, 0);
+      break;
+    }
+    blockLength[index] = n;
+    xQueueSend(readyQueue, &index, 0);
+  }
+  eof = true;  // readyQueue に積んだ後で立てる。finished() が最後のブロックを取りこぼさない
+  xSemaphoreGive(readerDone);
+}
+
+/**
+ * @brief WAV の 1 サンプルを 32bit 左詰めで取り出す
+ */
+static std::int32_t decodeSample(const std::uint8_t* p, std::uint16_t bits) {
+  switch (bits) {
+  case 8:
+    return ((std::int32_t)p[0] - 128) << 24;  // 8bit WAV は符号なし
+  case 16:
+    return (std::int32_t)((std::uint32_t)p[0] << 16 | (std::uint32_t)p[1] << 24);
+  case 24:
+    return (std::int32_t)((std::uint32_t)p[0] << 8 | (std::uint32_t)p[1] << 16 | (std::uint32_t)p[2] << 24);
+  default:
+    return (std::int32_t)((std::uint32_t)p[0] | (std::uint32_t)p[1] << 8 | (std::uint32_t)p[2] << 16 | (std::uint32_t)p[3] << 24);
+  }
+}
+
+std::size_t WavFileSource::fetch(std::uint8_t* block) {
+  const std::uint16_t srcAlign = header.getBlockAlign();
+  const std::size_t want = frames * srcAlign < remainingBytes ? frames * srcAlign : remainingBytes;
+  std::size_t got = fread(raw ? raw : block, 1, want, file);
+  if (got < want) {
+    log_e("WavFileSource: read error");
+    remainingBytes = 0;
+  } else {
+    remainingBytes -= got;
+  }
+  const std::size_t n = got / srcAlign;
+  if (raw) {
+    const std::uint16_t srcChannels = header.channels;
+    const std::uint8_t srcBytes = (std::uint8_t)(header.bitsPerSample / 8);
+    for (std::size_t i = 0; i < n; i++) {
+      const std::uint8_t* s = raw + i * srcAlign;
+      std::int32_t v[outChannels];
+      if (outChannels == 1 && 1 < srcChannels) {
+        std::int64_t sum = 0;  // ダウンミックスは平均
+        for (std::uint16_t c = 0; c < srcChannels; c++) {
+          sum += decodeSample(s + c * srcBytes, header.bitsPerSample);
+        }
+        v[0] = (std::int32_t)(sum / srcChannels);
+      } else {
+        for (std::uint8_t c = 0; c < outChannels; c++) {
+          const std::uint16_t sc = c < srcChannels ? c : srcChannels - 1;  // 足りないチャンネルは最後を複製
+          v[c] = decodeSample(s + sc * srcBytes, header.bitsPerSample);
+        }
+      }
+      if (outBytes == 2) {
+        std::int16_t* d = reinterpret_cast<std::int16_t*>(block) + i * outChannels;
+        for (std::uint8_t c = 0; c < outChannels; c++) {
+          d[c] = (std::int16_t)(v[c] >> 16);
+        }
+      } else {
+        std::int32_t* d = reinterpret_cast<std::int32_t*>(block) + i * outChannels;
+        for (std::uint8_t c = 0; c < outChannels; c++) {
+          d[c] = v[c];
+        }
+      }
+    }
+  }
+  const std::size_t produced = n * outChannels * outBytes;
+  memset(block + produced, 0, payloadSize - produced);  // 終端の端数は無音で埋める
+  return produced;
+}
+
+const WavHeader& WavFileSource::getHeader() const {
+  return header;
+}
+
+std::uint8_t WavFileSource::getReadyBlocks() const {
+  return (std::uint8_t)uxQueueMessagesWaiting(readyQueue);
+}
+
+std::uint32_t WavFileSource::getMaxFetchMicros() const {
+  return maxFetchMicros;
+}
+
+std::uint32_t WavFileSource::getHiddenStalls() const {
+  return hiddenStalls;
+}
+
+std::uint32_t WavFileSource::getUnderflows() const {
+  return underflows;
+}
@@ -0,0 +1,85 @@
+/**
+ * @copyright 2026 NOEX inc.
+ * @author Kenji Takahashi
+ */
+
+#include "../WavHeader.h"
+#include <string.h>
+
+#define WAVE_FORMAT_PCM 0x0001
+#define WAVE_FORMAT_EXTENSIBLE 0xFFFE
+
+static void put16(std::uint8_t* p, std::uint16_t v) {
+  p[0] = (std::uint8_t)v;
+  p[1] = (std::uint8_t)(v >> 8);
+}
+
+static void put32(std::uint8_t* p, std::uint32_t v) {
+  put16(p, (std::uint16_t)v);
+  put16(p + 2, (std::uint16_t)(v >> 16));
+}
+
+static std::uint16_t get16(const std::uint8_t* p) {
+  return (std::uint16_t)(p[0] | (p[1] << 8));
+}
+
+static std::uint32_t get32(const std::uint8_t* p) {
+  return (std::uint32_t)get16(p) | ((std::uint32_t)get16(p + 2) << 16);
+}
+
+bool WavHeader::write(FILE* file) {
+  std::uint8_t h[44];
+  memcpy(h, "RIFF", 4);
+  put32(h + 4, 36 + dataBytes);
+  memcpy(h + 8, "WAVEfmt ", 8);
+  put32(h + 16, 16);
+  put16(h + 20, WAVE_FORMAT_PCM);
+  put16(h + 22, channels);
+  put32(h + 24, sampleRate);
+  put32(h + 28, sampleRate * getBlockAlign());
+  put16(h + 32, getBlockAlign());
+  put16(h + 34, bitsPerSample);
+  memcpy(h + 36, "data", 4);
+  put32(h + 40, dataBytes);
+  dataOffset = sizeof(h);
+  return fseek(file, 0, SEEK_SET) == 0 && fwrite(h, 1, sizeof(h), file) == sizeof(h);
+}
+
+bool WavHeader::read(FILE* file) {
+  std::uint8_t h[12];
+  if (fseek(file, 0, SEEK_SET) != 0 || fread(h, 1, sizeof(h), file) != sizeof(h) ||
+      memcmp(h, "RIFF", 4) != 0 || memcmp(h + 8, "WAVE", 4) != 0) {
+    return false;
+  }
+  bool hasFormat = false;
+  for (;;) {
+    std::uint8_t c[8];
+    if (fread(c, 1, sizeof(c), file) != sizeof(c)) {
+      return false;
+    }
+    const std::uint32_t size = get32(c + 4);
+    if (memcmp(c, "fmt ", 4) == 0) {
+      std::uint8_t f[16];
+      if (size < sizeof(f) || fread(f, 1, sizeof(f), file) != sizeof(f)) {
+        return false;
+      }
+      const std::uint16_t format = get16(f);
+      if (format != WAVE_FORMAT_PCM && format != WAVE_FORMAT_EXTENSIBLE) {
+        return false;
+      }
+      channels = get16(f + 2);
+      sampleRate = get32(f + 4);
+      bitsPerSample = get16(f + 14);
+      hasFormat = true;
+      if (fseek(file, (long)(size - sizeof(f) + (size & 1)), SEEK_CUR) != 0) {
+        return false;
+      }
+    } else if (memcmp(c, "data", 4) == 0) {
+      dataBytes = size;
+      dataOffset = ftell(file);
+      return hasFormat && 0 < channels && 0 < bitsPerSample;
+    } else if (fseek(file, (long)(size + (size & 1)), SEEK_CUR) != 0) {  // チャンクは 2 バイト境界
+      return false;
+    }
+  }
+}